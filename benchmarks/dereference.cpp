@@ -0,0 +1,83 @@
+#include <cstddef>
+#include <string>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+
+#include "../cartesian_product_view.h"
+
+std::vector ints{ 0, 1, 2 };
+std::vector<std::string> strings{ "0", "1", "2" };
+
+template <std::size_t dimensions, typename Range>
+auto iterators(Range& range) {
+    return
+        [&]<std::size_t... indices>(std::index_sequence<indices...>) {
+            return std::tuple{ (static_cast<void>(indices), std::ranges::begin(range))... };
+        }(std::make_index_sequence<dimensions>{})
+    ;
+}
+
+// how cartesian_iterator<> used to build the reference tuple: one std::tuple_cat() per dimension
+template <std::size_t index, typename Iterators>
+auto read_recursively(Iterators const& its) {
+    if constexpr (index == std::tuple_size_v<Iterators>) {
+        return std::tuple{};
+    } else {
+        return std::tuple_cat(std::tuple<decltype(*std::get<index>(its))>{ *std::get<index>(its) }, read_recursively<index + 1>(its));
+    }
+}
+
+// how it builds the reference tuple now: in one shot
+template <typename Iterators>
+auto read_at_once(Iterators const& its) {
+    return std::apply([](auto const&... its) { return std::tuple<decltype(*its)...>{ *its... }; }, its);
+}
+
+template <std::size_t dimensions, auto& range>
+void recursive_tuple_cat(benchmark::State& state) {
+    auto its = iterators<dimensions>(range);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(its);
+        benchmark::DoNotOptimize(read_recursively<0>(its));
+    }
+}
+
+template <std::size_t dimensions, auto& range>
+void tuple_at_once(benchmark::State& state) {
+    auto its = iterators<dimensions>(range);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(its);
+        benchmark::DoNotOptimize(read_at_once(its));
+    }
+}
+
+template <std::size_t dimensions, auto& range>
+void cartesian_iterator(benchmark::State& state) {
+    auto cpv =
+        [&]<std::size_t... indices>(std::index_sequence<indices...>) {
+            return cartesian_product((static_cast<void>(indices), range)...);
+        }(std::make_index_sequence<dimensions>{})
+    ;
+
+    auto it = std::ranges::begin(cpv);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(it);
+        benchmark::DoNotOptimize(*it);
+    }
+}
+
+#define DEREFERENCE_BENCHMARK(dimensions)                          \
+    BENCHMARK_TEMPLATE(recursive_tuple_cat, dimensions, ints);     \
+    BENCHMARK_TEMPLATE(tuple_at_once, dimensions, ints);           \
+    BENCHMARK_TEMPLATE(cartesian_iterator, dimensions, ints);      \
+    BENCHMARK_TEMPLATE(recursive_tuple_cat, dimensions, strings);  \
+    BENCHMARK_TEMPLATE(tuple_at_once, dimensions, strings);        \
+    BENCHMARK_TEMPLATE(cartesian_iterator, dimensions, strings)
+
+DEREFERENCE_BENCHMARK(2);
+DEREFERENCE_BENCHMARK(4);
+DEREFERENCE_BENCHMARK(8);
+DEREFERENCE_BENCHMARK(16);
@@ -0,0 +1,61 @@
+#include <cstddef>
+#include <map>
+#include <utility>
+
+#include "benchmark/benchmark.h"
+
+#include "../cartesian_product_view.h"
+
+// the distribution of the sums of dice_count dice, as in examples/prob_dist_sum_dice.cpp
+template <std::size_t dice_count>
+auto dice() {
+    static std::size_t die[]{ 1, 2, 3, 4, 5, 6 };
+    return
+        [&]<std::size_t... indices>(std::index_sequence<indices...>) {
+            return cartesian_product((static_cast<void>(indices), die)...);
+        }(std::make_index_sequence<dice_count>{})
+    ;
+}
+
+// the tuples are enumerated (6^dice_count of them)
+template <std::size_t dice_count>
+void enumerated_sum_histogram(benchmark::State& state) {
+    auto cpv = dice<dice_count>();
+    for (auto _ : state) {
+        auto distribution =
+            cartesian_reduce(
+                cpv,
+                [](auto accumulator, auto const& tuple) { return cartesian_reduction::sum_histogram{}(std::move(accumulator), tuple); },
+                std::map<std::size_t, std::size_t>{}
+            )
+        ;
+        benchmark::DoNotOptimize(distribution);
+    }
+}
+
+// the distributions of the dice are convolved one at a time
+template <std::size_t dice_count>
+void separable_sum_histogram(benchmark::State& state) {
+    auto cpv = dice<dice_count>();
+    for (auto _ : state) {
+        auto distribution = cartesian_reduce(cpv, cartesian_reduction::sum_histogram{}, std::map<std::size_t, std::size_t>{});
+        benchmark::DoNotOptimize(distribution);
+    }
+}
+
+// enumerating 6^12 tuples would take minutes per iteration
+#define ENUMERATED_BENCHMARK(dice_count)                      \
+    BENCHMARK_TEMPLATE(enumerated_sum_histogram, dice_count); \
+    BENCHMARK_TEMPLATE(separable_sum_histogram, dice_count)
+
+ENUMERATED_BENCHMARK(2);
+ENUMERATED_BENCHMARK(3);
+ENUMERATED_BENCHMARK(4);
+ENUMERATED_BENCHMARK(5);
+ENUMERATED_BENCHMARK(6);
+ENUMERATED_BENCHMARK(7);
+ENUMERATED_BENCHMARK(8);
+BENCHMARK_TEMPLATE(separable_sum_histogram, 9);
+BENCHMARK_TEMPLATE(separable_sum_histogram, 10);
+BENCHMARK_TEMPLATE(separable_sum_histogram, 11);
+BENCHMARK_TEMPLATE(separable_sum_histogram, 12);
@@ -0,0 +1,344 @@
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <numeric>
+#include <random>
+#include <ranges>
+#include <span>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+
+#include "../cached_cartesian_product_view.h"
+#include "../cartesian_product_view.h"
+
+// every product has 2^16 tuples
+constexpr std::size_t extent(std::size_t const dimensions) {
+    return dimensions == 2 ? 256 : dimensions == 4 ? 16 : 4;
+}
+
+template <std::size_t dimensions>
+std::vector<int>& data() {
+    static std::vector<int> data = [] {
+        std::vector<int> data(extent(dimensions));
+        std::iota(data.begin(), data.end(), 0);
+        return data;
+    }();
+    return data;
+}
+
+struct vector_view {
+    template <std::size_t dimensions>
+    static auto make() {
+        return std::views::all(data<dimensions>());
+    }
+};
+
+// a view of static extent, whose radices are compile-time constants
+struct span_view {
+    template <std::size_t dimensions>
+    static auto make() {
+        return std::span<int, extent(dimensions)>{ data<dimensions>().data(), extent(dimensions) };
+    }
+};
+
+struct iota_view {
+    template <std::size_t dimensions>
+    static auto make() {
+        return std::views::iota(0, static_cast<int>(extent(dimensions)));
+    }
+};
+
+struct filter_view {
+    template <std::size_t dimensions>
+    static auto make() {
+        return data<dimensions>() | std::views::filter([](int const i) { return i >= 0; });
+    }
+};
+
+struct not_common_view {
+    template <std::size_t dimensions>
+    static auto make() {
+        return data<dimensions>() | std::views::take_while([](int const i) { return i >= 0; });
+    }
+};
+
+template <std::size_t dimensions, typename View>
+auto product() {
+    return
+        [&]<std::size_t... indices>(std::index_sequence<indices...>) {
+            return cartesian_product((static_cast<void>(indices), View::template make<dimensions>())...);
+        }(std::make_index_sequence<dimensions>{})
+    ;
+}
+
+auto sum(auto const& tuple) {
+    return std::apply([](auto const... elements) { return (0L + ... + elements); }, tuple);
+}
+
+template <std::size_t dimensions, typename View>
+void forward_traversal(benchmark::State& state) {
+    auto cpv = product<dimensions, View>();
+    for (auto _ : state) {
+        for (auto const& tuple : cpv) {
+            benchmark::DoNotOptimize(sum(tuple));
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * (1 << 16));
+}
+
+// the loop condition checks the outermost iterator only
+template <std::size_t dimensions, typename View>
+void sentinel_traversal(benchmark::State& state) {
+    auto cpv = product<dimensions, View>();
+    for (auto _ : state) {
+        for (auto it = std::ranges::begin(cpv); it != std::default_sentinel; ++it) {
+            benchmark::DoNotOptimize(sum(*it));
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * (1 << 16));
+}
+
+template <std::size_t dimensions, typename View>
+void internal_iteration(benchmark::State& state) {
+    auto cpv = product<dimensions, View>();
+    for (auto _ : state) {
+        cpv.for_each(
+            [](auto const& tuple) {
+                benchmark::DoNotOptimize(sum(tuple));
+            }
+        );
+    }
+    state.SetItemsProcessed(state.iterations() * (1 << 16));
+}
+
+template <std::size_t dimensions, typename View>
+void block_traversal(benchmark::State& state) {
+    auto cpv = product<dimensions, View>();
+    for (auto _ : state) {
+        for (auto const& tuple : cpv.blocks()) {
+            [&]<std::size_t... indices>(std::index_sequence<indices...>) {
+                auto const outer = (0L + ... + std::get<indices>(tuple));
+                for (auto const element : std::get<sizeof...(indices)>(tuple)) {
+                    benchmark::DoNotOptimize(outer + element);
+                }
+            }(std::make_index_sequence<dimensions - 1>{});
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * (1 << 16));
+}
+
+// the running sum is updated by the single element that changes per step
+template <std::size_t dimensions, typename View>
+void reflected_traversal(benchmark::State& state) {
+    auto cpv = product<dimensions, View>();
+    for (auto _ : state) {
+        auto const reflected = cpv.reflected();
+        auto it = reflected.begin();
+        auto total = sum(*it);
+        for (benchmark::DoNotOptimize(total); ++it != std::default_sentinel; benchmark::DoNotOptimize(total)) {
+            it.visit_change([&](auto, long const previous, long const current) { total += current - previous; });
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * (1 << 16));
+}
+
+template <std::size_t dimensions, typename View>
+void reverse_traversal(benchmark::State& state) {
+    auto cpv = product<dimensions, View>();
+    for (auto _ : state) {
+        for (auto const& tuple : cpv | std::views::reverse) {
+            benchmark::DoNotOptimize(sum(tuple));
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * (1 << 16));
+}
+
+template <std::size_t depth, typename View>
+void nested_loops(View& view, auto const&... elements) {
+    if constexpr (depth == 0) {
+        benchmark::DoNotOptimize((0L + ... + elements));
+    } else {
+        for (auto&& element : view) {
+            nested_loops<depth - 1>(view, elements..., element);
+        }
+    }
+}
+
+// the baseline: hand-written nested loops
+template <std::size_t dimensions, typename View>
+void nested_loops(benchmark::State& state) {
+    auto view = View::template make<dimensions>();
+    for (auto _ : state) {
+        nested_loops<dimensions>(view);
+    }
+    state.SetItemsProcessed(state.iterations() * (1 << 16));
+}
+
+#ifdef __cpp_lib_ranges_cartesian_product
+template <std::size_t dimensions, typename View>
+void std_cartesian_product(benchmark::State& state) {
+    auto view = View::template make<dimensions>();
+    auto cpv =
+        [&]<std::size_t... indices>(std::index_sequence<indices...>) {
+            return std::views::cartesian_product((static_cast<void>(indices), view)...);
+        }(std::make_index_sequence<dimensions>{})
+    ;
+    for (auto _ : state) {
+        for (auto const& tuple : cpv) {
+            benchmark::DoNotOptimize(sum(tuple));
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * (1 << 16));
+}
+#endif
+
+template <std::size_t dimensions, typename View>
+void random_jumps(benchmark::State& state) {
+    auto cpv = product<dimensions, View>();
+    std::vector<std::ptrdiff_t> jumps(1 << 10);
+    std::ranges::generate(jumps, [engine = std::mt19937{}]() mutable { return std::uniform_int_distribution<std::ptrdiff_t>{ 0, (1 << 16) - 1 }(engine); });
+
+    auto const begin = std::ranges::begin(cpv);
+    for (auto _ : state) {
+        for (auto const jump : jumps) {
+            benchmark::DoNotOptimize(sum(begin[jump]));
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(jumps.size()));
+}
+
+// iterators storing an index per dimension instead of the iterators of the views
+template <std::size_t dimensions, typename View>
+void compact_traversal(benchmark::State& state) {
+    auto cpv = product<dimensions, View>();
+    for (auto _ : state) {
+        for (auto const& tuple : cpv.compact()) {
+            benchmark::DoNotOptimize(sum(tuple));
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * (1 << 16));
+}
+
+template <std::size_t dimensions, typename View>
+void compact_random_jumps(benchmark::State& state) {
+    auto cpv = product<dimensions, View>();
+    std::vector<std::ptrdiff_t> jumps(1 << 10);
+    std::ranges::generate(jumps, [engine = std::mt19937{}]() mutable { return std::uniform_int_distribution<std::ptrdiff_t>{ 0, (1 << 16) - 1 }(engine); });
+
+    auto const begin = std::ranges::begin(cpv.compact());
+    for (auto _ : state) {
+        for (auto const jump : jumps) {
+            benchmark::DoNotOptimize(sum(begin[jump]));
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(jumps.size()));
+}
+
+// the same jumps converted to positions in bulk
+template <std::size_t dimensions, typename View>
+void batch_unrank(benchmark::State& state) {
+    auto cpv = product<dimensions, View>();
+    using difference_type = std::ranges::range_difference_t<decltype(cpv)>;
+    std::vector<difference_type> jumps(1 << 10);
+    std::ranges::generate(jumps, [engine = std::mt19937{}]() mutable { return std::uniform_int_distribution<difference_type>{ 0, (1 << 16) - 1 }(engine); });
+    std::vector<std::array<difference_type, dimensions>> positions(jumps.size());
+
+    for (auto _ : state) {
+        cpv.unrank(jumps, positions);
+        benchmark::DoNotOptimize(positions.data());
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(jumps.size()));
+}
+
+// comparing equal iterators, which has to check every dimension
+template <std::size_t dimensions, typename View>
+void equality(benchmark::State& state) {
+    auto cpv = product<dimensions, View>();
+    auto it = std::ranges::begin(cpv);
+    auto jt = it;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(it);
+        benchmark::DoNotOptimize(jt);
+        benchmark::DoNotOptimize(it == jt);
+    }
+}
+
+template <std::size_t dimensions, typename View>
+void size(benchmark::State& state) {
+    auto cpv = product<dimensions, View>();
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(cpv);
+        benchmark::DoNotOptimize(std::ranges::size(cpv));
+    }
+}
+
+#ifdef __cpp_lib_ranges_cartesian_product
+#define STD_CARTESIAN_PRODUCT_BENCHMARK(dimensions, View) BENCHMARK_TEMPLATE(std_cartesian_product, dimensions, View)
+#else
+#define STD_CARTESIAN_PRODUCT_BENCHMARK(dimensions, View) static_assert(true)
+#endif
+
+#define TRAVERSAL_BENCHMARK(dimensions, View)                  \
+    BENCHMARK_TEMPLATE(nested_loops, dimensions, View);        \
+    STD_CARTESIAN_PRODUCT_BENCHMARK(dimensions, View);         \
+    BENCHMARK_TEMPLATE(forward_traversal, dimensions, View);   \
+    BENCHMARK_TEMPLATE(sentinel_traversal, dimensions, View);  \
+    BENCHMARK_TEMPLATE(internal_iteration, dimensions, View);  \
+    BENCHMARK_TEMPLATE(block_traversal, dimensions, View);     \
+    BENCHMARK_TEMPLATE(reflected_traversal, dimensions, View); \
+    BENCHMARK_TEMPLATE(reverse_traversal, dimensions, View)
+
+#define RANDOM_ACCESS_BENCHMARK(dimensions, View)                \
+    BENCHMARK_TEMPLATE(random_jumps, dimensions, View);         \
+    BENCHMARK_TEMPLATE(batch_unrank, dimensions, View);         \
+    BENCHMARK_TEMPLATE(compact_traversal, dimensions, View);    \
+    BENCHMARK_TEMPLATE(compact_random_jumps, dimensions, View); \
+    BENCHMARK_TEMPLATE(size, dimensions, View)
+
+#define BENCHMARKS(dimensions)                              \
+    TRAVERSAL_BENCHMARK(dimensions, vector_view);           \
+    TRAVERSAL_BENCHMARK(dimensions, span_view);             \
+    TRAVERSAL_BENCHMARK(dimensions, iota_view);             \
+    TRAVERSAL_BENCHMARK(dimensions, filter_view);           \
+    TRAVERSAL_BENCHMARK(dimensions, not_common_view);       \
+    RANDOM_ACCESS_BENCHMARK(dimensions, vector_view);       \
+    RANDOM_ACCESS_BENCHMARK(dimensions, span_view);         \
+    RANDOM_ACCESS_BENCHMARK(dimensions, iota_view);         \
+    BENCHMARK_TEMPLATE(equality, dimensions, vector_view);  \
+    BENCHMARK_TEMPLATE(equality, dimensions, filter_view)
+
+BENCHMARKS(2);
+BENCHMARKS(4);
+BENCHMARKS(8);
+
+// an inner pipeline that is expensive to evaluate, which the regular product evaluates once per outer element
+auto expensive_view() {
+    return data<2>() | std::views::transform([](int const i) { return std::sqrt(std::sqrt(static_cast<double>(i)) + 1.0); });
+}
+
+void reevaluated_inner(benchmark::State& state) {
+    auto cpv = cartesian_product(data<2>(), expensive_view());
+    for (auto _ : state) {
+        for (auto const& [outer, inner] : cpv) {
+            benchmark::DoNotOptimize(outer + inner);
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * (1 << 16));
+}
+
+// the inner pipeline is materialized once per product (included in the measurement)
+void cached_inner(benchmark::State& state) {
+    for (auto _ : state) {
+        for (auto const& [outer, inner] : cached_cartesian_product(data<2>(), expensive_view())) {
+            benchmark::DoNotOptimize(outer + inner);
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * (1 << 16));
+}
+
+BENCHMARK(reevaluated_inner);
+BENCHMARK(cached_inner);
@@ -0,0 +1,331 @@
+#ifndef CACHED_CARTESIAN_PRODUCT_VIEW_H
+#define CACHED_CARTESIAN_PRODUCT_VIEW_H
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdio>
+#include <iterator>
+#include <memory>
+#include <memory_resource>
+#include <new>
+#include <optional>
+#include <ranges>
+#include <span>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#if __has_include(<sys/mman.h>) && __has_include(<unistd.h>)
+#include <sys/mman.h>
+#include <unistd.h>
+#define CARTESIAN_PRODUCT_VIEW_MMAP
+#endif
+
+#include "cartesian_product_view.h"
+
+// The product of an input_range (e.g. a stream) and of further input_ranges that are materialized once on construction,
+// into contiguous buffers allocated from an arena owned by the view: the outermost range is read a single time, and
+// the inner ones are traversed as std::span<>s of their cached elements, so an expensive pipeline (a transform, a filter)
+// isn't evaluated for every element of the outermost range again. The elements of the inner ranges are const, while the
+// ones of the outermost range are referred to, if they are lvalues, and are kept by the iterator otherwise (so the tuples
+// don't outlive it, i.e. the product is an input_range only).
+// Given a cartesian_memory_limit, the buffers take up that much heap memory at most, the rest of them is placed in
+// memory-mapped temporary files (where the platform provides mmap(), std::bad_alloc is thrown beyond the limit otherwise),
+// so that inner ranges exceeding the physical memory are paged in and out by the operating system.
+template <typename Outer, typename... Inners>
+class cached_cartesian_product_view final : public std::ranges::view_base {
+    static_assert(std::ranges::input_range<Outer> && std::ranges::view<Outer>);
+    static_assert((... && (std::ranges::input_range<Inners> && std::ranges::view<Inners>)));
+
+    using outer_reference = std::ranges::range_reference_t<Outer>;
+
+    static constexpr bool cache_outer = !std::is_lvalue_reference_v<outer_reference>;
+
+    using inner_product = cartesian_product_view<true, std::span<std::ranges::range_value_t<Inners> const>...>;
+
+    // allocates from the heap up to the limit, and maps a temporary file of the requested size beyond it
+    class spilling_resource final : public std::pmr::memory_resource {
+    public:
+        explicit spilling_resource(std::size_t const limit)
+            : limit{ limit }
+        {}
+
+        spilling_resource(spilling_resource const&) = delete;
+        spilling_resource& operator=(spilling_resource const&) = delete;
+
+        ~spilling_resource() override {
+#ifdef CARTESIAN_PRODUCT_VIEW_MMAP
+            for (auto const& [address, bytes] : mappings) {
+                ::munmap(address, bytes);
+            }
+#endif
+        }
+
+        // the number of bytes placed in temporary files
+        std::size_t spilled() const {
+            std::size_t spilled = 0;
+            for (auto const& mapping : mappings) {
+                spilled += mapping.second;
+            }
+
+            return spilled;
+        }
+
+    private:
+        void* do_allocate(std::size_t const bytes, std::size_t const alignment) override {
+            if (bytes <= limit - used) {
+                auto const address = std::pmr::new_delete_resource()->allocate(bytes, alignment);
+                used += bytes;
+                return address;
+            }
+
+#ifdef CARTESIAN_PRODUCT_VIEW_MMAP
+            // the file is removed as soon as it's closed, while the mapping keeps its pages until it's unmapped
+            std::FILE* const file = std::tmpfile();
+            if (file == nullptr) {
+                throw std::bad_alloc{};
+            }
+
+            void* address = MAP_FAILED;
+            if (::ftruncate(::fileno(file), static_cast<off_t>(bytes)) == 0) {
+                address = ::mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, ::fileno(file), 0);
+            }
+            std::fclose(file);
+
+            if (address == MAP_FAILED) {
+                throw std::bad_alloc{};
+            }
+
+            mappings.emplace_back(address, bytes);
+            return address;
+#else
+            throw std::bad_alloc{};
+#endif
+        }
+
+        void do_deallocate(void* const address, std::size_t const bytes, std::size_t const alignment) override {
+            auto const mapping = std::ranges::find(mappings, address, &std::pair<void*, std::size_t>::first);
+            if (mapping == mappings.end()) {
+                std::pmr::new_delete_resource()->deallocate(address, bytes, alignment);
+                used -= bytes;
+                return;
+            }
+
+#ifdef CARTESIAN_PRODUCT_VIEW_MMAP
+            ::munmap(address, bytes);
+#endif
+            mappings.erase(mapping);
+        }
+
+        bool do_is_equal(std::pmr::memory_resource const& other) const noexcept override {
+            return this == &other;
+        }
+
+        std::size_t limit;
+        std::size_t used{};
+        std::vector<std::pair<void*, std::size_t>> mappings{};
+    };
+
+    // the buffers are allocated from a monotonic arena (exactly sized, if the inner ranges are sized_ranges), which is
+    // released as a whole along with the view; they are kept on the heap, so that moving the view leaves them in place
+    class storage {
+    public:
+        explicit storage(std::size_t const limit, Inners&... inners)
+            : resource{ limit }
+            , buffers{ materialize(inners)... }
+            , product{ std::apply([](auto const&... buffers) { return inner_product{ std::span{ buffers }... }; }, buffers) }
+        {}
+
+        storage(storage const&) = delete;
+        storage& operator=(storage const&) = delete;
+
+        inner_product& elements() {
+            return product;
+        }
+
+        std::size_t spilled() const {
+            return resource.spilled();
+        }
+
+    private:
+        template <typename Inner>
+        std::pmr::vector<std::ranges::range_value_t<Inner>> materialize(Inner& inner) {
+            std::pmr::vector<std::ranges::range_value_t<Inner>> buffer{ &arena };
+            if constexpr (std::ranges::sized_range<Inner>) {
+                buffer.reserve(static_cast<std::size_t>(std::ranges::size(inner)));
+            }
+
+            for (auto&& element : inner) {
+                buffer.emplace_back(std::forward<decltype(element)>(element));
+            }
+
+            return buffer;
+        }
+
+        spilling_resource resource;
+        std::pmr::monotonic_buffer_resource arena{ &resource };
+        std::tuple<std::pmr::vector<std::ranges::range_value_t<Inners>>...> buffers;
+        inner_product product;
+    };
+
+    class iterator {
+        using inner_iterator = std::ranges::iterator_t<inner_product>;
+
+        using outer_element_t = std::conditional_t<cache_outer, std::ranges::range_value_t<Outer> const&, outer_reference>;
+
+        // the references of a forward iterator have to remain valid after it's gone, so they can't refer to the iterator itself
+        static constexpr bool forward = std::ranges::forward_range<Outer> && !cache_outer;
+
+    public:
+        using iterator_category = std::input_iterator_tag;
+        using iterator_concept  = std::conditional_t<forward, std::forward_iterator_tag, std::input_iterator_tag>;
+        using difference_type   = std::common_type_t<std::ranges::range_difference_t<Outer>, std::iter_difference_t<inner_iterator>>;
+        using value_type        = std::tuple<std::ranges::range_value_t<Outer>, std::ranges::range_value_t<Inners>...>;
+        using reference         = std::tuple<outer_element_t, std::ranges::range_value_t<Inners> const&...>;
+
+        iterator() = default;
+
+        iterator(std::ranges::iterator_t<Outer> outer, cached_cartesian_product_view* parent)
+            : parent{ parent }
+            , outer{ std::move(outer) }
+            , inner{ parent->cache->elements().begin() }
+        {
+            load();
+        }
+
+        iterator& operator++() {
+            assert(*this != std::default_sentinel && "Attempting to increment end cached_cartesian_product_view<> iterator!");
+
+            if (++inner == std::default_sentinel) {
+                ++outer;
+                inner = parent->cache->elements().begin();
+                load();
+            }
+
+            return *this;
+        }
+
+        auto operator++(int) {
+            if constexpr (forward) {
+                auto ret = *this;
+                ++*this;
+                return ret;
+            } else {
+                ++*this;
+            }
+        }
+
+        reference operator*() const {
+            assert(*this != std::default_sentinel && "Attempting to dereference end cached_cartesian_product_view<> iterator!");
+
+            return
+                std::apply(
+                    [&](auto&&... elements) {
+                        return reference{ outer_element(), std::forward<decltype(elements)>(elements)... };
+                    },
+                    *inner
+                )
+            ;
+        }
+
+        bool operator==(iterator const& other) const requires forward {
+            return inner == other.inner && outer == other.outer;
+        }
+
+        // the product is empty, if any of the inner ranges is
+        bool operator==(std::default_sentinel_t) const {
+            return inner == std::default_sentinel || outer == std::ranges::end(parent->outer);
+        }
+
+    private:
+        // reads the current element of the outermost range, unless it can be referred to
+        void load() {
+            if constexpr (cache_outer) {
+                if (*this != std::default_sentinel) {
+                    current.emplace(*outer);
+                }
+            }
+        }
+
+        outer_element_t outer_element() const {
+            if constexpr (cache_outer) {
+                return *current;
+            } else {
+                return *outer;
+            }
+        }
+
+        cached_cartesian_product_view* parent{};
+        std::ranges::iterator_t<Outer> outer{};
+        inner_iterator inner{};
+        [[no_unique_address]] std::conditional_t<cache_outer, std::optional<std::ranges::range_value_t<Outer>>, std::tuple<>> current{};
+    };
+
+public:
+    cached_cartesian_product_view(Outer outer, Inners... inners)
+        : cached_cartesian_product_view{ cartesian_memory_limit{ static_cast<std::size_t>(-1) }, std::move(outer), std::move(inners)... }
+    {}
+
+    cached_cartesian_product_view(cartesian_memory_limit const limit, Outer outer, Inners... inners)
+        : outer{ std::move(outer) }
+        , cache{ std::make_unique<storage>(limit.bytes, inners...) }
+    {}
+
+    // the outermost range may be an input_range, so begin() may be called once only (as for the range itself)
+    iterator begin() {
+        return { std::ranges::begin(outer), this };
+    }
+
+    std::default_sentinel_t end() const {
+        return std::default_sentinel;
+    }
+
+    auto size() requires std::ranges::sized_range<Outer> {
+        return static_cast<std::size_t>(std::ranges::size(outer)) * static_cast<std::size_t>(cache->elements().size());
+    }
+
+    // the number of bytes of the buffers placed in memory-mapped temporary files because of the memory limit
+    std::size_t spilled() const {
+        return cache->spilled();
+    }
+
+private:
+    Outer outer;
+    std::unique_ptr<storage> cache;
+};
+
+struct cached_cartesian_product_fn {
+    template <typename Outer, typename... Inners>
+    requires (
+        sizeof...(Inners) != 0
+     && std::ranges::input_range<Outer> && std::ranges::viewable_range<Outer>
+     && (... && (std::ranges::input_range<Inners> && std::ranges::viewable_range<Inners>))
+    )
+    auto operator()(Outer&& outer, Inners&&... inners) const {
+        return (*this)(cartesian_memory_limit{ static_cast<std::size_t>(-1) }, std::forward<Outer>(outer), std::forward<Inners>(inners)...);
+    }
+
+    template <typename Outer, typename... Inners>
+    requires (
+        sizeof...(Inners) != 0
+     && std::ranges::input_range<Outer> && std::ranges::viewable_range<Outer>
+     && (... && (std::ranges::input_range<Inners> && std::ranges::viewable_range<Inners>))
+    )
+    auto operator()(cartesian_memory_limit const limit, Outer&& outer, Inners&&... inners) const {
+        return
+            cached_cartesian_product_view<std::views::all_t<Outer>, std::views::all_t<Inners>...>{
+                limit,
+                std::views::all(std::forward<Outer>(outer)),
+                std::views::all(std::forward<Inners>(inners))...
+            }
+        ;
+    }
+};
+
+inline constexpr cached_cartesian_product_fn cached_cartesian_product{};
+
+#undef CARTESIAN_PRODUCT_VIEW_MMAP
+
+#endif
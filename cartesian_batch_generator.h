@@ -0,0 +1,252 @@
+#ifndef CARTESIAN_BATCH_GENERATOR_H
+#define CARTESIAN_BATCH_GENERATOR_H
+
+#include <cassert>
+#include <coroutine>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <ranges>
+#include <span>
+#include <utility>
+#include <vector>
+
+#include "cartesian_product_view.h"
+
+// Resumes coroutines on the calling thread: spawn() queues a task, co_await schedule() requeues the awaiting coroutine
+// (so that the others can proceed, e.g. while an I/O operation is pending), and run() resumes the queued coroutines
+// until there's none left, then rethrows the first exception that escaped a task.
+class cartesian_local_executor {
+public:
+    class task {
+    public:
+        struct promise_type {
+            task get_return_object() noexcept {
+                return task{ std::coroutine_handle<promise_type>::from_promise(*this) };
+            }
+
+            std::suspend_always initial_suspend() noexcept {
+                return {};
+            }
+
+            std::suspend_never final_suspend() noexcept {
+                return {};
+            }
+
+            void return_void() noexcept {}
+
+            void unhandled_exception() noexcept {
+                if (!executor->exception) {
+                    executor->exception = std::current_exception();
+                }
+            }
+
+            cartesian_local_executor* executor{};
+        };
+
+        task(task&& other) noexcept
+            : handle{ std::exchange(other.handle, nullptr) }
+        {}
+
+        task& operator=(task&& other) noexcept {
+            std::swap(handle, other.handle);
+            return *this;
+        }
+
+        // a task that hasn't been spawned is destroyed without ever running
+        ~task() {
+            if (handle) {
+                handle.destroy();
+            }
+        }
+
+    private:
+        explicit task(std::coroutine_handle<promise_type> const handle) noexcept
+            : handle{ handle }
+        {}
+
+        std::coroutine_handle<promise_type> handle{};
+
+        friend cartesian_local_executor;
+    };
+
+    cartesian_local_executor() = default;
+
+    cartesian_local_executor(cartesian_local_executor const&) = delete;
+    cartesian_local_executor& operator=(cartesian_local_executor const&) = delete;
+
+    // the tasks that haven't completed by the time the executor is destroyed are destroyed as well
+    ~cartesian_local_executor() {
+        for (auto const handle : ready) {
+            handle.destroy();
+        }
+    }
+
+    // the task starts running on the next run()
+    void spawn(task t) {
+        t.handle.promise().executor = this;
+        ready.push_back(std::exchange(t.handle, nullptr));
+    }
+
+    auto schedule() noexcept {
+        struct awaiter {
+            constexpr bool await_ready() const noexcept {
+                return false;
+            }
+
+            void await_suspend(std::coroutine_handle<> const handle) const {
+                executor->ready.push_back(handle);
+            }
+
+            constexpr void await_resume() const noexcept {}
+
+            cartesian_local_executor* executor;
+        };
+
+        return awaiter{ this };
+    }
+
+    void run() {
+        while (!ready.empty()) {
+            auto const handle = ready.front();
+            ready.pop_front();
+            handle.resume();
+        }
+
+        if (exception) {
+            std::rethrow_exception(std::exchange(exception, nullptr));
+        }
+    }
+
+private:
+    std::deque<std::coroutine_handle<>> ready{};
+    std::exception_ptr exception{};
+};
+
+// The tuples of a product in batches, produced on demand by a coroutine: co_await next() resumes the producer, which
+// fills the next batch and suspends, transferring control back to the awaiting coroutine (so there's a single batch
+// in flight, and the enumeration doesn't run ahead of the consumer). The batch remains valid until the next co_await,
+// and an empty one marks the end; the exceptions thrown by the producer are rethrown by co_await next().
+template <typename Reference>
+class cartesian_batch_generator {
+public:
+    using batch_type = std::span<Reference const>;
+
+    struct promise_type {
+        cartesian_batch_generator get_return_object() noexcept {
+            return cartesian_batch_generator{ std::coroutine_handle<promise_type>::from_promise(*this) };
+        }
+
+        std::suspend_always initial_suspend() noexcept {
+            return {};
+        }
+
+        auto final_suspend() noexcept {
+            return yield_value(batch_type{});
+        }
+
+        auto yield_value(batch_type const batch) noexcept {
+            struct awaiter {
+                constexpr bool await_ready() const noexcept {
+                    return false;
+                }
+
+                std::coroutine_handle<> await_suspend(std::coroutine_handle<>) const noexcept {
+                    return consumer;
+                }
+
+                constexpr void await_resume() const noexcept {}
+
+                std::coroutine_handle<> consumer;
+            };
+
+            this->batch = batch;
+            return awaiter{ std::exchange(consumer, nullptr) };
+        }
+
+        void return_void() noexcept {}
+
+        void unhandled_exception() noexcept {
+            exception = std::current_exception();
+        }
+
+        batch_type batch{};
+        std::coroutine_handle<> consumer{};
+        std::exception_ptr exception{};
+    };
+
+    cartesian_batch_generator(cartesian_batch_generator&& other) noexcept
+        : handle{ std::exchange(other.handle, nullptr) }
+    {}
+
+    cartesian_batch_generator& operator=(cartesian_batch_generator&& other) noexcept {
+        std::swap(handle, other.handle);
+        return *this;
+    }
+
+    ~cartesian_batch_generator() {
+        if (handle) {
+            handle.destroy();
+        }
+    }
+
+    auto next() {
+        struct awaiter {
+            bool await_ready() const noexcept {
+                return producer.done();
+            }
+
+            std::coroutine_handle<> await_suspend(std::coroutine_handle<> const consumer) const noexcept {
+                producer.promise().consumer = consumer;
+                return producer;
+            }
+
+            batch_type await_resume() const {
+                auto& promise = producer.promise();
+                if (promise.exception) {
+                    std::rethrow_exception(std::exchange(promise.exception, nullptr));
+                }
+
+                return producer.done() ? batch_type{} : promise.batch;
+            }
+
+            std::coroutine_handle<promise_type> producer;
+        };
+
+        return awaiter{ handle };
+    }
+
+private:
+    explicit cartesian_batch_generator(std::coroutine_handle<promise_type> const handle) noexcept
+        : handle{ handle }
+    {}
+
+    std::coroutine_handle<promise_type> handle{};
+};
+
+// Enumerates a product (which must outlive the generator) in batches of batch_size tuples (the last one may be smaller),
+// so that the tuples are handed over to an asynchronous consumer once per batch, rather than one by one.
+struct cartesian_batches_fn {
+    template <std::ranges::input_range R>
+    cartesian_batch_generator<std::ranges::range_reference_t<R>> operator()(R& cpv, std::size_t const batch_size) const {
+        assert(batch_size != 0 && "Attempting to split cartesian_product_view<> into empty batches!");
+
+        std::vector<std::ranges::range_reference_t<R>> batch{};
+        batch.reserve(batch_size);
+        for (auto&& tuple : cpv) {
+            batch.push_back(std::forward<decltype(tuple)>(tuple));
+            if (batch.size() == batch_size) {
+                co_yield std::span{ std::as_const(batch) };
+                batch.clear();
+            }
+        }
+
+        if (!batch.empty()) {
+            co_yield std::span{ std::as_const(batch) };
+        }
+    }
+};
+
+inline constexpr cartesian_batches_fn cartesian_batches{};
+
+#endif
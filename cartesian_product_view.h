@@ -1,176 +1,238 @@
 #ifndef CARTESIAN_PRODUCT_VIEW_H
 #define CARTESIAN_PRODUCT_VIEW_H
 
+#include <algorithm>
+#include <array>
+#include <atomic>
 #include <cassert>
+#include <compare>
+#include <concepts>
 #include <cstddef>
 #include <cstdint>
+#include <deque>
+#include <exception>
+#include <functional>
 #include <iterator>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <optional>
 #include <ranges>
+#include <span>
+#include <stdexcept>
+#include <thread>
 #include <tuple>
 #include <type_traits>
 #include <utility>
+#include <vector>
 
-template <bool deep_const, typename... Views>
-class cartesian_product_view final : public std::ranges::view_base {
-    static_assert((... && (std::ranges::forward_range<Views> && std::ranges::view<Views>)));
-
+namespace cartesian_detail {
+    // a value that's computed on first need and is reused afterwards; it's shared by all of the users of its owner
+    // (e.g. the iterators of the same view), hence the synchronization
     template <typename T>
-    struct arrow_proxy {
-        T t;
+    class lazy_cache {
+    public:
+        lazy_cache() = default;
 
-        T operator*() && {
-            return t;
+        // the cached value is computed from the source of the owner, so it's never propagated
+        constexpr lazy_cache(lazy_cache const&) noexcept
+            : lazy_cache{}
+        {}
+
+        constexpr lazy_cache& operator=(lazy_cache const& other) noexcept {
+            if (this != &other) {
+                value.reset();
+                if (!std::is_constant_evaluated()) {
+                    cached.store(false, std::memory_order_relaxed);
+                }
+            }
+
+            return *this;
         }
 
-        T* operator->() {
-            return &t;
+        template <typename Compute>
+        constexpr T get(Compute const compute) {
+            // there's nothing to share during constant evaluation
+            if (std::is_constant_evaluated()) {
+                return compute();
+            }
+
+            if (!cached.load(std::memory_order_acquire)) {
+                std::scoped_lock const lock{ mutex };
+                if (!cached.load(std::memory_order_relaxed)) {
+                    value.emplace(compute());
+                    cached.store(true, std::memory_order_release);
+                }
+            }
+
+            return *value;
         }
-    };
 
-    template <bool propagate_const, std::size_t index, std::size_t size, typename ViewsTuple>
-    class cartesian_iterator : protected cartesian_iterator<propagate_const, index + 1, size, ViewsTuple> {
-        using base = cartesian_iterator<propagate_const, index + 1, size, ViewsTuple>;
-        using aux = cartesian_iterator<propagate_const, size, size, ViewsTuple>;
+    private:
+        std::optional<T> value{};
+        std::atomic<bool> cached{};
+        std::mutex mutex{};
+    };
 
+    // an object that may not be assignable (e.g. a lambda with captures), wrapped so that it's assigned by being
+    // destroyed and constructed again, which keeps the views storing it assignable (as by std::ranges::filter_view<>)
+    template <typename T>
+    class assignable_box {
     public:
-        using aux::iterator_category;
-        using aux::iterator_concept;
-        using aux::difference_type;
-        using aux::value_type;
-        using aux::reference;
-        using aux::pointer;
-
-        cartesian_iterator() = default;
+        assignable_box() requires std::default_initializable<T>
+            : value{ std::in_place }
+        {}
 
-        cartesian_iterator(bool const begin_end, ViewsTuple* views)
-          : base{ begin_end, views }
-          , it{
-                !begin_end
-              ? std::ranges::begin(std::get<index>(*views))
-              : [&] {
-                    auto& views = std::get<index>(*aux::views);
-                    if constexpr (std::ranges::common_range<std::tuple_element_t<index, ViewsTuple>>) {
-                        return std::ranges::end(views);
-                    } else {
-                        return std::ranges::next(std::ranges::begin(views), std::ranges::end(views));
-                    }
-                }()
-            }
+        constexpr explicit assignable_box(T t)
+            : value{ std::in_place, std::move(t) }
         {}
 
-        cartesian_iterator& operator++() {
-            assert(!empty() && "Attempting to increment empty cartesian_product_view<> iterator!");
-            assert(it != std::ranges::end(std::get<index>(*aux::views)) && "Attempting to increment end cartesian_product_view<> iterator!");
+        assignable_box(assignable_box const&) = default;
+        assignable_box(assignable_box&&) = default;
 
-            static_cast<void>(next());
-            return *this;
-        }
+        constexpr assignable_box& operator=(assignable_box const& other) {
+            if (this != &other) {
+                value.reset();
+                value.emplace(*other.value);
+            }
 
-        cartesian_iterator operator++(int) {
-            auto ret = *this;
-            ++*this;
-            return ret;
+            return *this;
         }
 
-        typename aux::reference operator*() const {
-            assert(!empty() && "Attempting to dereference empty cartesian_product_view<> iterator!");
-            assert(it != std::ranges::end(std::get<index>(*aux::views)) && "Attempting to dereference end cartesian_product_view<> iterator!");
+        constexpr assignable_box& operator=(assignable_box&& other) {
+            if (this != &other) {
+                value.reset();
+                value.emplace(std::move(*other.value));
+            }
 
-            return read();
+            return *this;
         }
 
-        typename aux::pointer operator->() const {
-            return { **this };
+        constexpr T const& operator*() const {
+            return *value;
         }
 
-        bool operator==(cartesian_iterator const& other) const {
-#ifndef NDEBUG
-            return base::operator==(other) && it == other.it;
+    private:
+        std::optional<T> value;
+    };
+}
+
+template <bool deep_const, typename... Views>
+class cartesian_product_view final : public std::ranges::view_base {
+    static_assert((... && (std::ranges::forward_range<Views> && std::ranges::view<Views>)));
+
+    // define CARTESIAN_PRODUCT_VIEW_WIDE_INDEX to index the tuples with 128-bit integers (where available),
+    // so that products of more than 2^63 - 1 tuples can still be sized, partitioned and jumped around
+#if defined(CARTESIAN_PRODUCT_VIEW_WIDE_INDEX)
+#if !defined(__SIZEOF_INT128__)
+#error "CARTESIAN_PRODUCT_VIEW_WIDE_INDEX requires a compiler with 128-bit integers"
+#endif
+    // e.g. libstdc++ only treats __int128 as an integer (std::make_unsigned<>, std::numeric_limits<>, ...) in gnu++ modes
+    __extension__ static_assert(std::is_integral_v<__int128>, "CARTESIAN_PRODUCT_VIEW_WIDE_INDEX requires a standard library that supports __int128");
+    __extension__ using index_type = std::conditional_t<std::is_integral_v<__int128>, __int128, std::intmax_t>;
 #else
-            return it == other.it && base::operator==(other);
+    using index_type = std::intmax_t;
 #endif
-        }
 
-        cartesian_iterator& operator--() requires (... && std::ranges::bidirectional_range<Views>) {
-            assert(!empty() && "Attempting to decrement empty cartesian_product_view<> iterator!");
+    using difference_type = std::common_type_t<index_type, std::ranges::range_difference_t<Views>...>;
+    using size_type = std::make_unsigned_t<index_type>;
 
-            if (it == std::ranges::end(std::get<index>(*aux::views))) {
-                reset_rbegin();
-            } else {
-                auto const underflow = prev();
-                assert(!underflow && "Attempting to decrement begin cartesian_product_view<> iterator!");
-            }
+    // the size of the views whose size is part of their type, std::dynamic_extent for the rest
+    template <typename View>
+    struct static_extent : std::integral_constant<std::size_t, std::dynamic_extent> {};
 
-            return *this;
-        }
+    template <typename View>
+    struct static_extent<View const> : static_extent<View> {};
 
-        cartesian_iterator operator--(int) requires (... && std::ranges::bidirectional_range<Views>) {
-            auto ret = *this;
-            --*this;
-            return ret;
-        }
+    template <typename T, std::size_t N>
+    struct static_extent<T[N]> : std::integral_constant<std::size_t, N> {};
 
-    protected:
-        bool next() {
-            if (base::next()){
-                if (++it != std::ranges::end(std::get<index>(*aux::views))) {
-                    base::reset_begin();
-                } else {
-                    return true;
-                }
-            }
+    template <typename T, std::size_t N>
+    struct static_extent<std::array<T, N>> : std::integral_constant<std::size_t, N> {};
 
-            return false;
-        }
+    template <typename T, std::size_t N>
+    struct static_extent<std::span<T, N>> : std::integral_constant<std::size_t, N> {};
 
-        bool prev() requires (... && std::ranges::bidirectional_range<Views>) {
-            if (base::prev()) {
-                if (it != std::ranges::begin(std::get<index>(*aux::views))) {
-                    --it;
-                    base::reset_rbegin();
-                } else {
-                    return true;
-                }
-            }
+    template <typename Range>
+    struct static_extent<std::ranges::ref_view<Range>> : static_extent<Range> {};
 
-            return false;
-        }
+#if __cpp_lib_ranges >= 202110L
+    template <typename Range>
+    struct static_extent<std::ranges::owning_view<Range>> : static_extent<Range> {};
+#endif
 
-        auto read() const {
-            return std::tuple_cat(std::tuple<std::tuple_element_t<index, typename aux::reference>>{ *it }, base::read());
-        }
+    static constexpr bool static_extents = (... && (static_extent<Views>::value != std::dynamic_extent));
+
+    // if all of the views are borrowed_ranges, the iterators keep the ends of the views themselves instead of
+    // pointing to the cartesian_product_view<>, so they outlive it (i.e. the product is a borrowed_range as well)
+    static constexpr bool borrowed = (... && std::ranges::enable_borrowed_range<Views>);
+
+    // whether order contains every index of the views exactly once
+    template <std::size_t... order>
+    static constexpr bool permutation() {
+        return
+            sizeof...(order) == sizeof...(Views)
+         && [&]<std::size_t... indices>(std::index_sequence<indices...>) {
+                auto const count = [](std::size_t const index) { return (std::size_t{} + ... + std::size_t{ order == index }); };
+                return (... && (count(indices) == 1));
+            }(std::index_sequence_for<Views...>{})
+        ;
+    }
 
-        void reset_begin() {
-            base::reset_begin();
-            it = std::ranges::begin(std::get<index>(*aux::views));
+    // the position of the view at index in the traversal order
+    template <std::size_t... order>
+    static constexpr std::size_t rank(std::size_t const index) {
+        std::size_t rank = 0;
+        static_cast<void>((... || (order == index || (++rank, false))));
+        return rank;
+    }
+
+    struct none {};
+
+    template <typename T>
+    struct arrow_proxy {
+        T t;
+
+        constexpr T operator*() && {
+            return t;
         }
 
-        void reset_rbegin() requires (... && std::ranges::bidirectional_range<Views>) {
-            base::reset_rbegin();
-            it =
-                [&] {
-                    auto& views = std::get<index>(*aux::views);
-                    if constexpr (std::ranges::common_range<std::tuple_element_t<index, ViewsTuple>>) {
-                        return std::ranges::prev(std::ranges::end(views));
-                    } else {
-                        return std::ranges::prev(std::ranges::next(std::ranges::begin(views), std::ranges::end(views)));
-                    }
-                }()
-            ;
+        constexpr T* operator->() {
+            return &t;
         }
+    };
 
-#ifndef NDEBUG
-        bool empty() const {
-            return std::ranges::empty(std::get<index>(*aux::views)) || base::empty();
+    // the end iterator of a non-common view, which takes linear time to compute, so it's computed on first need
+    // (i.e. when the end of the product is formed or a reverse traversal wraps around) and is reused afterwards
+    // by all of the iterators of the same cartesian_product_view<>
+    template <typename View>
+    class end_cache {
+    public:
+        constexpr std::ranges::iterator_t<View> get(View& view) {
+            return it.get([&] { return std::ranges::next(std::ranges::begin(view), std::ranges::end(view)); });
         }
-#endif
 
     private:
-        std::ranges::iterator_t<std::tuple_element_t<index, ViewsTuple>> it;
+        cartesian_detail::lazy_cache<std::ranges::iterator_t<View>> it{};
+    };
+
+    template <typename View>
+    requires (!std::ranges::range<View> || std::ranges::common_range<View>)
+    class end_cache<View> {
+    public:
+        constexpr auto get(View& view) const {
+            return std::ranges::end(view);
+        }
     };
 
-    template <bool propagate_const, std::size_t size, typename ViewsTuple>
-    class cartesian_iterator<propagate_const, size, size, ViewsTuple> {
+    template <bool propagate_const, typename Parent>
+    class cartesian_iterator {
+        template <typename View>
+        using maybe_const = std::conditional_t<std::is_const_v<Parent>, View const, View>;
+
+        using ViewsTuple = maybe_const<std::tuple<Views...>>;
+
         class iterator_traits {
             template <std::ranges::range Range>
             class element {
@@ -193,23 +255,28 @@ class cartesian_product_view final : public std::ranges::view_base {
             template <std::ranges::range Range>
             using element_t = typename element<Range>::type;
 
-            template <typename View>
-            using maybe_const = std::conditional_t<std::is_const_v<ViewsTuple>, View const, View>;
-
         public:
+            // this is the strongest legacy category that holds: Cpp17ForwardIterator requires reference to be
+            // (const) value_type&, but reference is a prvalue std::tuple<> of the references of the views;
+            // algorithms taking an execution policy should be fed with the legacy random access iterators of
+            // the std::vector<> returned by chunks() instead
             using iterator_category = std::input_iterator_tag;
 
             using iterator_concept =
                 std::conditional_t<
-                    (... && std::ranges::bidirectional_range<maybe_const<Views>>),
-                    std::bidirectional_iterator_tag,
-                    std::forward_iterator_tag
+                    (... && (std::ranges::random_access_range<maybe_const<Views>> && std::ranges::sized_range<maybe_const<Views>>)),
+                    std::random_access_iterator_tag,
+                    std::conditional_t<
+                        (... && std::ranges::bidirectional_range<maybe_const<Views>>),
+                        std::bidirectional_iterator_tag,
+                        std::forward_iterator_tag
+                    >
                 >
             ;
 
             using difference_type =
                 std::common_type_t<
-                    std::intmax_t,
+                    index_type,
                     std::ranges::range_difference_t<maybe_const<Views>>...
                 >
             ;
@@ -229,166 +296,1838 @@ class cartesian_product_view final : public std::ranges::view_base {
         using reference         = typename iterator_traits::reference;
         using pointer           = typename iterator_traits::pointer;
 
+        using iterators = std::tuple<std::ranges::iterator_t<maybe_const<Views>>...>;
+
+    private:
+        // the ends of the views, as iterators if the product is borrowed: there's no cartesian_product_view<> to ask
+        // for the cached end iterator of a non-common view, so it's kept by the iterator itself
+        using sentinels = std::conditional_t<borrowed, iterators, std::tuple<std::ranges::sentinel_t<maybe_const<Views>>...>>;
+
+        static constexpr bool bidirectional = std::derived_from<iterator_concept, std::bidirectional_iterator_tag>;
+        static constexpr bool random_access = std::derived_from<iterator_concept, std::random_access_iterator_tag>;
+
+        static constexpr std::size_t innermost = sizeof...(Views) - 1;
+
+        friend cartesian_product_view;
+
+    public:
         cartesian_iterator() = default;
 
-        cartesian_iterator(bool, ViewsTuple* views)
-            : views{ views }
+        constexpr cartesian_iterator(bool const begin_end, Parent* parent)
+            : cartesian_iterator{ make_iterators(begin_end, *parent, std::index_sequence_for<Views...>{}), parent }
         {}
 
-        cartesian_iterator& operator++() {
-            assert(!"Attempting to increment empty cartesian_product_view<> iterator!");
+        // points to the tuple of *its (if std::get<0>(its) is the end of the outermost view, the others must be
+        // the beginnings of their views, which is the end of the product)
+        constexpr cartesian_iterator(iterators its, Parent* parent)
+            : its{ std::move(its) }
+            , begins{ std::apply([](auto&... views) { return iterators{ std::ranges::begin(views)... }; }, parent->views) }
+            , ends{ make_ends(*parent, std::index_sequence_for<Views...>{}) }
+        {
+            if constexpr (!borrowed) {
+                this->parent = parent;
+            }
+        }
+
+        constexpr cartesian_iterator& operator++() {
+            if constexpr (sizeof...(Views) == 0) {
+                assert(!"Attempting to increment empty cartesian_product_view<> iterator!");
+            } else {
+                assert(!empty() && "Attempting to increment empty cartesian_product_view<> iterator!");
+                assert(std::get<0>(its) != std::get<0>(ends) && "Attempting to increment end cartesian_product_view<> iterator!");
+
+                next<innermost>();
+            }
 
             return *this;
         }
 
-        cartesian_iterator operator++(int) {
+        constexpr cartesian_iterator operator++(int) {
             auto ret = *this;
             ++*this;
             return ret;
         }
 
-        auto operator*() const {
-            assert(!"Attempting to dereference empty cartesian_product_view<> iterator!");
+        constexpr reference operator*() const {
+            if constexpr (sizeof...(Views) == 0) {
+                assert(!"Attempting to dereference empty cartesian_product_view<> iterator!");
+            } else {
+                assert(!empty() && "Attempting to dereference empty cartesian_product_view<> iterator!");
+                assert(std::get<0>(its) != std::get<0>(ends) && "Attempting to dereference end cartesian_product_view<> iterator!");
+            }
 
-            return std::tuple{};
+            return std::apply([](auto const&... its) { return reference{ *its... }; }, its);
         }
 
-        arrow_proxy<std::tuple<>> operator->() const {
+        constexpr pointer operator->() const {
             return { **this };
         }
 
-        bool operator==(cartesian_iterator const& other) const {
-            assert(views == other.views && "Attempting to compare incompatible cartesian_product_view<> iterators!");
+        constexpr bool operator==(cartesian_iterator const& other) const {
+            assert(compatible(other) && "Attempting to compare incompatible cartesian_product_view<> iterators!");
+
+            // starting with the innermost iterators, as they are the most likely to differ
+            return
+                [&]<std::size_t... indices>(std::index_sequence<indices...>) {
+                    return (... && (std::get<innermost - indices>(its) == std::get<innermost - indices>(other.its)));
+                }(std::index_sequence_for<Views...>{})
+            ;
+        }
+
+        // skips the rest of the tuples sharing the elements of the views [0, level] with the current one, i.e. increments
+        // the iterator of the view at level (carrying over to the outer views) and resets the inner ones to their beginnings,
+        // e.g. to prune the search space once a prefix is rejected; returns the outermost level that changed
+        constexpr std::size_t skip_suffix(std::size_t const level) {
+            if constexpr (sizeof...(Views) == 0) {
+                assert(!"Attempting to increment empty cartesian_product_view<> iterator!");
+
+                return 0;
+            } else {
+                assert(level < sizeof...(Views) && "Attempting to skip the suffix of cartesian_product_view<> iterator at a nonexistent level!");
+                assert(!empty() && "Attempting to increment empty cartesian_product_view<> iterator!");
+                assert(std::get<0>(its) != std::get<0>(ends) && "Attempting to increment end cartesian_product_view<> iterator!");
+
+                return
+                    [&]<std::size_t... indices>(std::index_sequence<indices...>) {
+                        std::size_t changed = 0;
+                        static_cast<void>((... || (indices == level && (changed = skip<indices>(), true))));
+                        return changed;
+                    }(std::index_sequence_for<Views...>{})
+                ;
+            }
+        }
 
-            return true;
+        // the end of the product is detectable by the outermost iterator alone, so comparing against std::default_sentinel
+        // takes a single comparison (end() returns an iterator nevertheless, so that the product is a common_range)
+        constexpr bool operator==(std::default_sentinel_t) const {
+            if constexpr (sizeof...(Views) == 0) {
+                return true;
+            } else {
+                return std::get<0>(its) == std::get<0>(ends);
+            }
         }
 
-        cartesian_iterator& operator--() {
-            assert(!"Attempting to decrement empty cartesian_product_view<> iterator!");
+        constexpr cartesian_iterator& operator--() requires bidirectional {
+            if constexpr (sizeof...(Views) == 0) {
+                assert(!"Attempting to decrement empty cartesian_product_view<> iterator!");
+            } else {
+                assert(!empty() && "Attempting to decrement empty cartesian_product_view<> iterator!");
+
+                prev<innermost>();
+            }
 
             return *this;
         }
 
-        cartesian_iterator operator--(int) {
+        constexpr cartesian_iterator operator--(int) requires bidirectional {
             auto ret = *this;
             --*this;
             return ret;
         }
 
-    protected:
-        bool prev() const {
-            return true;
+        constexpr cartesian_iterator& operator+=(difference_type const n) requires random_access {
+            if constexpr (sizeof...(Views) == 0) {
+                assert(n == 0 && "Attempting to advance empty cartesian_product_view<> iterator!");
+            } else if (n != 0) {
+                auto target = distance<innermost>(1) + n;
+                assert(0 <= target && "Attempting to advance cartesian_product_view<> iterator out of range!");
+
+                seek<innermost>(target);
+            }
+
+            return *this;
+        }
+
+        constexpr cartesian_iterator& operator-=(difference_type const n) requires random_access {
+            return *this += -n;
         }
 
-        bool next() const {
-            return true;
+        friend constexpr cartesian_iterator operator+(cartesian_iterator i, difference_type const n) requires random_access {
+            return i += n;
         }
 
-        auto read() const {
-            return std::tuple{};
+        friend constexpr cartesian_iterator operator+(difference_type const n, cartesian_iterator i) requires random_access {
+            return i += n;
         }
 
-        void reset_begin() const {}
+        friend constexpr cartesian_iterator operator-(cartesian_iterator i, difference_type const n) requires random_access {
+            return i -= n;
+        }
 
-        void reset_rbegin() const {}
+        friend constexpr difference_type operator-(cartesian_iterator const& lhs, cartesian_iterator const& rhs) requires random_access {
+            assert(lhs.compatible(rhs) && "Attempting to subtract incompatible cartesian_product_view<> iterators!");
 
-#ifndef NDEBUG
-        bool empty() const {
-            return false; // despite seeming to be controversial
+            if constexpr (sizeof...(Views) == 0) {
+                return 0;
+            } else {
+                return lhs.template distance<innermost>(1) - rhs.template distance<innermost>(1);
+            }
         }
-#endif
 
-        ViewsTuple* views;
-    };
+        constexpr reference operator[](difference_type const n) const requires random_access {
+            return *(*this + n);
+        }
 
-public:
-    cartesian_product_view() = default;
+        constexpr std::strong_ordering operator<=>(cartesian_iterator const& other) const requires random_access {
+            assert(compatible(other) && "Attempting to compare incompatible cartesian_product_view<> iterators!");
 
-    cartesian_product_view(Views... views) requires (sizeof...(Views) != 0)
-        : views{ std::move(views)... }
-    {}
+            return *this - other <=> 0;
+        }
 
-    auto begin() {
-        return iterator(false, views);
-    }
+    private:
+        template <std::size_t... indices>
+        static constexpr sentinels make_ends(Parent& parent, std::index_sequence<indices...>) {
+            if constexpr (borrowed) {
+                return sentinels{ parent.template end_iterator<indices>()... };
+            } else {
+                return sentinels{ std::ranges::end(std::get<indices>(parent.views))... };
+            }
+        }
 
-    auto end() {
-        return iterator(true, views);
-    }
+        template <std::size_t... indices>
+        static constexpr iterators make_iterators(bool const begin_end, Parent& parent, std::index_sequence<indices...>) {
+            return {
+                begin_end && indices == 0
+              ? parent.template end_iterator<indices>()
+              : std::ranges::begin(std::get<indices>(parent.views))...
+            };
+        }
 
-    auto begin() const {
-        return iterator(false, views);
-    }
+        // increments the iterator of the view at index and carries over to the outer views when it reaches the end,
+        // so the end of the product is the end of the outermost view along with the beginnings of the others
+        template <std::size_t index>
+        constexpr void next() {
+            auto& it = std::get<index>(its);
+            if (++it != std::get<index>(ends)) [[likely]] {
+                return;
+            }
 
-    auto end() const {
-        return iterator(true, views);
-    }
+            if constexpr (index != 0) {
+                it = first<index>();
+                next<index - 1>();
+            }
+        }
 
-    auto cbegin() const {
-        return begin();
-    }
+        template <std::size_t index>
+        constexpr std::size_t skip() {
+            [&]<std::size_t... inner>(std::index_sequence<inner...>) {
+                ((std::get<index + 1 + inner>(its) = first<index + 1 + inner>()), ...);
+            }(std::make_index_sequence<innermost - index>{});
+            next<index>();
 
-    auto cend() const {
-        return end();
-    }
+            return changed<index>();
+        }
 
-    auto size() requires (... && std::ranges::sized_range<Views>) {
-        return size(views);
-    }
+        // the innermost level up to index whose iterator isn't at the beginning of its view after a carry,
+        // i.e. the one that was incremented (or 0 at the end)
+        template <std::size_t index>
+        constexpr std::size_t changed() const {
+            if constexpr (index == 0) {
+                return 0;
+            } else {
+                return std::get<index>(its) != first<index>() ? index : changed<index - 1>();
+            }
+        }
 
-    auto size() const requires (... && std::ranges::sized_range<Views const>) {
-        return size(views);
-    }
+        template <std::size_t index>
+        constexpr void prev() {
+            auto& it = std::get<index>(its);
+            if constexpr (index != 0) {
+                if (it == first<index>()) {
+                    it = last<index>();
+                    prev<index - 1>();
+                }
+            } else {
+                assert(it != first<index>() && "Attempting to decrement begin cartesian_product_view<> iterator!");
+            }
 
-private:
-    template <typename T>
-    static auto iterator(bool const begin_end, T& views) {
-        return
-            cartesian_iterator<
-                deep_const && std::is_const_v<T>,
-                0,
-                sizeof...(Views),
-                std::remove_reference_t<decltype(views)>
-            > {
-                begin_end
-             || std::apply(
-                    [](auto&... views) {
-                        return (... || std::ranges::empty(views));
-                    },
-                    views
-                ),
-                &views
+            --it;
+        }
+
+        // the number of tuples preceding the current one, i.e. its value in the mixed-radix numeral system
+        // whose radices are the sizes of the views (accumulated from the innermost view outwards)
+        template <std::size_t index>
+        constexpr difference_type distance(difference_type const stride) const {
+            auto const digit = static_cast<difference_type>(std::get<index>(its) - first<index>());
+            if constexpr (index == 0) {
+                return digit * stride;
+            } else {
+                return digit * stride + distance<index - 1>(stride * radix<index>());
             }
-        ;
-    }
+        }
 
-    template <typename T>
-    static auto size(T& views) {
-        return
-            std::apply(
-                [](auto&... views) {
-                    return (std::size_t{ sizeof...(views) != 0 } * ... * std::ranges::size(views));
-                },
-                views
-            )
+        // sets the iterators to the digits of n (starting with the innermost view), the outermost digit being
+        // the size of the outermost view gives the end
+        template <std::size_t index>
+        constexpr void seek(difference_type& n) {
+            using view_difference_type = std::iter_difference_t<std::tuple_element_t<index, iterators>>;
+            auto const radix = this->radix<index>();
+            if constexpr (index == 0) {
+                assert(n <= radix && "Attempting to advance cartesian_product_view<> iterator out of range!");
+
+                std::get<index>(its) = first<index>() + static_cast<view_difference_type>(n);
+            } else {
+                assert(radix != 0 && "Attempting to advance empty cartesian_product_view<> iterator!");
+
+                std::get<index>(its) = first<index>() + static_cast<view_difference_type>(n % radix);
+                n /= radix;
+                seek<index - 1>(n);
+            }
+        }
+
+        // the beginning of the view at index, which is kept rather than asked for on every carry
+        template <std::size_t index>
+        constexpr auto const& first() const {
+            return std::get<index>(begins);
+        }
+
+        // the end of the view at index as an iterator
+        template <std::size_t index>
+        constexpr auto last() const {
+            if constexpr (borrowed) {
+                return std::get<index>(ends);
+            } else {
+                return parent->template end_iterator<index>();
+            }
+        }
+
+        template <std::size_t index>
+        constexpr difference_type radix() const {
+            if constexpr (!borrowed) {
+                return cartesian_product_view::radix<index>(parent->views);
+            } else if constexpr (constexpr auto extent = static_extent<std::tuple_element_t<index, std::tuple<Views...>>>::value; extent != std::dynamic_extent) {
+                return static_cast<difference_type>(extent);
+            } else {
+                return static_cast<difference_type>(std::ranges::distance(first<index>(), std::get<index>(ends)));
+            }
+        }
+
+        constexpr bool compatible(cartesian_iterator const& other) const {
+            if constexpr (borrowed) {
+                return begins == other.begins;
+            } else {
+                return parent == other.parent;
+            }
+        }
+
+#ifndef NDEBUG
+        constexpr bool empty() const {
+            return
+                [&]<std::size_t... indices>(std::index_sequence<indices...>) {
+                    return (... || (first<indices>() == std::get<indices>(ends)));
+                }(std::index_sequence_for<Views...>{})
+            ;
+        }
+#endif
+
+        [[no_unique_address]] std::conditional_t<borrowed, none, Parent*> parent{};
+        iterators its{};
+        iterators begins{};
+        sentinels ends{};
+    };
+
+    // the iterator of compact(): the position within every view is an index of the narrowest unsigned integer type
+    // that holds the size of the view, if it's of static extent, or an Index otherwise, so there's a single pointer
+    // to the views and no iterator of theirs to store
+    template <typename Index, bool propagate_const, typename Parent>
+    class compact_iterator {
+        using base = cartesian_iterator<propagate_const, Parent>;
+
+        template <typename View, std::size_t extent = static_extent<View>::value>
+        using index_t =
+            std::conditional_t<
+                extent == std::dynamic_extent,
+                Index,
+                std::conditional_t<
+                    extent <= std::numeric_limits<std::uint8_t>::max(),
+                    std::uint8_t,
+                    std::conditional_t<
+                        extent <= std::numeric_limits<std::uint16_t>::max(),
+                        std::uint16_t,
+                        std::conditional_t<
+                            extent <= std::numeric_limits<std::uint32_t>::max(),
+                            std::uint32_t,
+                            std::uint64_t
+                        >
+                    >
+                >
+            >
         ;
-    }
 
-    std::tuple<Views...> views;
-};
+        static constexpr std::size_t innermost = sizeof...(Views) - 1;
 
-template <typename... Ranges>
-cartesian_product_view(Ranges&&...) -> cartesian_product_view<true, std::views::all_t<Ranges>...>;
+    public:
+        using iterator_category = std::input_iterator_tag;
+        using iterator_concept  = std::random_access_iterator_tag;
+        using difference_type   = typename base::difference_type;
+        using value_type        = typename base::value_type;
+        using reference         = typename base::reference;
+        using pointer           = typename base::pointer;
+
+        using indices = std::tuple<index_t<Views>...>;
+
+        compact_iterator() = default;
+
+        constexpr compact_iterator(bool const begin_end, Parent* parent)
+            : parent{ parent }
+        {
+            if constexpr (sizeof...(Views) != 0) {
+                if (begin_end || std::apply([](auto&... views) { return (... || std::ranges::empty(views)); }, parent->views)) {
+                    std::get<0>(positions) = static_cast<std::tuple_element_t<0, indices>>(radix<0>());
+                }
+            }
+        }
 
-template <bool deep_const>
-struct cartesian_product_fn {
-    template <typename... Ranges>
-    requires (... && (std::ranges::forward_range<Ranges> && std::ranges::viewable_range<Ranges>))
-    constexpr auto operator()(Ranges&&... ranges) const {
-        return cartesian_product_view<deep_const, std::views::all_t<Ranges>...>{ std::views::all(std::forward<Ranges>(ranges))... };
-    }
-};
+        constexpr compact_iterator& operator++() {
+            if constexpr (sizeof...(Views) == 0) {
+                assert(!"Attempting to increment empty cartesian_product_view<> iterator!");
+            } else {
+                assert(static_cast<difference_type>(std::get<0>(positions)) != radix<0>() && "Attempting to increment end cartesian_product_view<> iterator!");
 
-inline constexpr cartesian_product_fn<true> cartesian_product{};
+                next<innermost>();
+            }
+
+            return *this;
+        }
+
+        constexpr compact_iterator operator++(int) {
+            auto ret = *this;
+            ++*this;
+            return ret;
+        }
+
+        constexpr reference operator*() const {
+            if constexpr (sizeof...(Views) == 0) {
+                assert(!"Attempting to dereference empty cartesian_product_view<> iterator!");
+            } else {
+                assert(static_cast<difference_type>(std::get<0>(positions)) != radix<0>() && "Attempting to dereference end cartesian_product_view<> iterator!");
+            }
+
+            return
+                [&]<std::size_t... indices>(std::index_sequence<indices...>) {
+                    return reference{ std::ranges::begin(std::get<indices>(parent->views))[std::get<indices>(positions)]... };
+                }(std::index_sequence_for<Views...>{})
+            ;
+        }
+
+        constexpr pointer operator->() const {
+            return { **this };
+        }
+
+        constexpr bool operator==(compact_iterator const& other) const {
+            assert(parent == other.parent && "Attempting to compare incompatible cartesian_product_view<> iterators!");
+
+            // starting with the innermost positions, as they are the most likely to differ
+            return
+                [&]<std::size_t... indices>(std::index_sequence<indices...>) {
+                    return (... && (std::get<innermost - indices>(positions) == std::get<innermost - indices>(other.positions)));
+                }(std::index_sequence_for<Views...>{})
+            ;
+        }
+
+        constexpr bool operator==(std::default_sentinel_t) const {
+            if constexpr (sizeof...(Views) == 0) {
+                return true;
+            } else {
+                return static_cast<difference_type>(std::get<0>(positions)) == radix<0>();
+            }
+        }
+
+        constexpr compact_iterator& operator--() {
+            if constexpr (sizeof...(Views) == 0) {
+                assert(!"Attempting to decrement empty cartesian_product_view<> iterator!");
+            } else {
+                prev<innermost>();
+            }
+
+            return *this;
+        }
+
+        constexpr compact_iterator operator--(int) {
+            auto ret = *this;
+            --*this;
+            return ret;
+        }
+
+        constexpr compact_iterator& operator+=(difference_type const n) {
+            if constexpr (sizeof...(Views) == 0) {
+                assert(n == 0 && "Attempting to advance empty cartesian_product_view<> iterator!");
+            } else if (n != 0) {
+                auto target = distance<innermost>(1) + n;
+                assert(0 <= target && "Attempting to advance cartesian_product_view<> iterator out of range!");
+
+                seek<innermost>(target);
+            }
+
+            return *this;
+        }
+
+        constexpr compact_iterator& operator-=(difference_type const n) {
+            return *this += -n;
+        }
+
+        friend constexpr compact_iterator operator+(compact_iterator i, difference_type const n) {
+            return i += n;
+        }
+
+        friend constexpr compact_iterator operator+(difference_type const n, compact_iterator i) {
+            return i += n;
+        }
+
+        friend constexpr compact_iterator operator-(compact_iterator i, difference_type const n) {
+            return i -= n;
+        }
+
+        friend constexpr difference_type operator-(compact_iterator const& lhs, compact_iterator const& rhs) {
+            assert(lhs.parent == rhs.parent && "Attempting to subtract incompatible cartesian_product_view<> iterators!");
+
+            if constexpr (sizeof...(Views) == 0) {
+                return 0;
+            } else {
+                return lhs.template distance<innermost>(1) - rhs.template distance<innermost>(1);
+            }
+        }
+
+        constexpr reference operator[](difference_type const n) const {
+            return *(*this + n);
+        }
+
+        // the positions are ordered from the outermost view inwards, so they compare lexicographically
+        constexpr std::strong_ordering operator<=>(compact_iterator const& other) const {
+            assert(parent == other.parent && "Attempting to compare incompatible cartesian_product_view<> iterators!");
+
+            return positions <=> other.positions;
+        }
+
+    private:
+        template <std::size_t index>
+        constexpr difference_type radix() const {
+            return cartesian_product_view::radix<index>(parent->views);
+        }
+
+        // the same carry as the one of cartesian_iterator, on indices
+        template <std::size_t index>
+        constexpr void next() {
+            auto& position = std::get<index>(positions);
+            if constexpr (index != 0) {
+                if (static_cast<difference_type>(++position) != radix<index>()) [[likely]] {
+                    return;
+                }
+
+                position = 0;
+                next<index - 1>();
+            } else {
+                ++position;
+            }
+        }
+
+        template <std::size_t index>
+        constexpr void prev() {
+            auto& position = std::get<index>(positions);
+            if constexpr (index != 0) {
+                if (position == 0) {
+                    position = static_cast<std::tuple_element_t<index, indices>>(radix<index>());
+                    prev<index - 1>();
+                }
+            } else {
+                assert(position != 0 && "Attempting to decrement begin cartesian_product_view<> iterator!");
+            }
+
+            --position;
+        }
+
+        template <std::size_t index>
+        constexpr difference_type distance(difference_type const stride) const {
+            auto const digit = static_cast<difference_type>(std::get<index>(positions));
+            if constexpr (index == 0) {
+                return digit * stride;
+            } else {
+                return digit * stride + distance<index - 1>(stride * radix<index>());
+            }
+        }
+
+        template <std::size_t index>
+        constexpr void seek(difference_type& n) {
+            using index_type = std::tuple_element_t<index, indices>;
+            auto const radix = this->radix<index>();
+            if constexpr (index == 0) {
+                assert(n <= radix && "Attempting to advance cartesian_product_view<> iterator out of range!");
+
+                std::get<index>(positions) = static_cast<index_type>(n);
+            } else {
+                assert(radix != 0 && "Attempting to advance empty cartesian_product_view<> iterator!");
+
+                std::get<index>(positions) = static_cast<index_type>(n % radix);
+                n /= radix;
+                seek<index - 1>(n);
+            }
+        }
+
+        Parent* parent{};
+        indices positions{};
+    };
+
+    // the iterator of reflected(): the inner views are traversed back and forth alternately (i.e. in the order of
+    // the reflected mixed-radix Gray code), so consecutive tuples differ in a single element, whose level is kept
+    template <bool propagate_const, typename Parent>
+    class reflected_iterator {
+        using base = cartesian_iterator<propagate_const, Parent>;
+
+        static constexpr std::size_t innermost = sizeof...(Views) - 1;
+
+    public:
+        using iterator_category = std::input_iterator_tag;
+        using iterator_concept  = std::forward_iterator_tag;
+        using difference_type   = typename base::difference_type;
+        using value_type        = typename base::value_type;
+        using reference         = typename base::reference;
+        using pointer           = typename base::pointer;
+
+        reflected_iterator() = default;
+
+        // the end is the end of the outermost view along with the beginnings of the others, as for cartesian_iterator,
+        // whose cached ends and beginnings (or pointer to the views) are reused
+        constexpr reflected_iterator(bool const begin_end, Parent* parent)
+            : it{ begin_end, parent }
+        {
+            forward.fill(true);
+        }
+
+        constexpr reflected_iterator& operator++() {
+            assert(*this != std::default_sentinel && "Attempting to increment end cartesian_product_view<> iterator!");
+
+            next<innermost>();
+            return *this;
+        }
+
+        constexpr reflected_iterator operator++(int) {
+            auto ret = *this;
+            ++*this;
+            return ret;
+        }
+
+        constexpr reference operator*() const {
+            assert(*this != std::default_sentinel && "Attempting to dereference end cartesian_product_view<> iterator!");
+
+            return *it;
+        }
+
+        constexpr pointer operator->() const {
+            return { **this };
+        }
+
+        // the tuples are visited once each, so the iterators of the views determine the position on their own
+        constexpr bool operator==(reflected_iterator const& other) const {
+            return it == other.it;
+        }
+
+        constexpr bool operator==(std::default_sentinel_t) const {
+            return it == std::default_sentinel;
+        }
+
+        // the level of the element that was changed by the last increment (0 at the end), or sizeof...(Views) if the
+        // iterator hasn't been incremented yet, i.e. there's no previous tuple to differ from
+        constexpr std::size_t changed() const {
+            return level;
+        }
+
+        // invokes f(std::integral_constant<std::size_t, level>{}, previous, current) with the element that was changed
+        // by the last increment before and after it, so that e.g. a running sum is updated by a single subtraction and
+        // addition per tuple, regardless of the number of views; f isn't invoked before the first increment
+        template <typename F>
+        constexpr void visit_change(F&& f) const {
+            assert(*this != std::default_sentinel && "Attempting to dereference end cartesian_product_view<> iterator!");
+
+            [&]<std::size_t... indices>(std::index_sequence<indices...>) {
+                static_cast<void>((... || (indices == level && (visit_change<indices>(f), true))));
+            }(std::index_sequence_for<Views...>{});
+        }
+
+    private:
+        // moves the iterator of the view at index in its current direction; if it's at the last element in that
+        // direction, the direction is reversed instead and the move is carried over to the outer views
+        template <std::size_t index>
+        constexpr void next() {
+            auto& current = std::get<index>(it.its);
+            if constexpr (index == 0) {
+                level = 0;
+                if (++current == std::get<index>(it.ends)) {
+                    // the end of the product is the end of the outermost view along with the beginnings of the others
+                    [&]<std::size_t... inner>(std::index_sequence<inner...>) {
+                        ((std::get<1 + inner>(it.its) = it.template first<1 + inner>()), ...);
+                    }(std::make_index_sequence<innermost>{});
+                    forward.fill(true);
+                }
+            } else if (forward[index]) {
+                if (auto successor = std::ranges::next(current); successor != std::get<index>(it.ends)) [[likely]] {
+                    current = std::move(successor);
+                    level = index;
+                } else {
+                    forward[index] = false;
+                    next<index - 1>();
+                }
+            } else if (current != it.template first<index>()) [[likely]] {
+                --current;
+                level = index;
+            } else {
+                forward[index] = true;
+                next<index - 1>();
+            }
+        }
+
+        template <std::size_t index, typename F>
+        constexpr void visit_change(F& f) const {
+            using element_t = std::tuple_element_t<index, reference>;
+
+            auto const& current = std::get<index>(it.its);
+            auto const previous = forward[index] ? std::ranges::prev(current) : std::ranges::next(current);
+            std::invoke(f, std::integral_constant<std::size_t, index>{}, static_cast<element_t>(*previous), static_cast<element_t>(*current));
+        }
+
+        base it{};
+        std::array<bool, sizeof...(Views)> forward{};
+        std::size_t level = sizeof...(Views);
+    };
+
+public:
+    cartesian_product_view() = default;
+
+    constexpr cartesian_product_view(Views... views) requires (sizeof...(Views) != 0)
+        : views{ std::move(views)... }
+    {}
+
+    constexpr auto begin() {
+        return iterator(false, *this);
+    }
+
+    constexpr auto end() {
+        return iterator(true, *this);
+    }
+
+    constexpr auto begin() const requires (... && std::ranges::range<Views const>) {
+        return iterator(false, *this);
+    }
+
+    constexpr auto end() const requires (... && std::ranges::range<Views const>) {
+        return iterator(true, *this);
+    }
+
+    constexpr auto cbegin() const requires (... && std::ranges::range<Views const>) {
+        return begin();
+    }
+
+    constexpr auto cend() const requires (... && std::ranges::range<Views const>) {
+        return end();
+    }
+
+    constexpr auto size() requires (!static_extents && (... && std::ranges::sized_range<Views>)) {
+        return size(views);
+    }
+
+    constexpr auto size() const requires (!static_extents && (... && std::ranges::sized_range<Views const>)) {
+        return size(views);
+    }
+
+    // the size of the product, or std::nullopt if it overflows (i.e. the distance between the iterators isn't representable)
+    constexpr std::optional<size_type> checked_size() requires (... && std::ranges::sized_range<Views>) {
+        return checked_size(views);
+    }
+
+    constexpr std::optional<size_type> checked_size() const requires (... && std::ranges::sized_range<Views const>) {
+        return checked_size(views);
+    }
+
+    // a product of views of static extent (std::array<>s, fixed-size std::span<>s, ...) has a static size
+    static constexpr size_type size() requires static_extents {
+        constexpr auto size = checked_product({ static_cast<size_type>(static_extent<Views>::value)... });
+        static_assert(size.has_value(), "The static size of cartesian_product_view<> overflows!");
+        return *size;
+    }
+
+    // the tuples [first, last) in a subrange, located in O(sizeof...(Views)) steps
+    constexpr auto partition(difference_type const first, difference_type const last)
+        requires (... && (std::ranges::random_access_range<Views> && std::ranges::sized_range<Views>))
+    {
+        return partition(*this, first, last);
+    }
+
+    constexpr auto partition(difference_type const first, difference_type const last) const
+        requires (... && (std::ranges::random_access_range<Views const> && std::ranges::sized_range<Views const>))
+    {
+        return partition(*this, first, last);
+    }
+
+    // the flat index of the tuple pointed to by it (i.e. the number of tuples preceding it), computed in O(sizeof...(Views)) steps
+    template <bool propagate_const, typename Parent>
+    requires std::same_as<std::remove_const_t<Parent>, cartesian_product_view> && cartesian_iterator<propagate_const, Parent>::random_access
+    constexpr difference_type index_of(cartesian_iterator<propagate_const, Parent> const& it) const {
+        if constexpr (!borrowed) {
+            assert(it.parent == this && "Attempting to index cartesian_product_view<> with the iterator of another one!");
+        }
+
+        return it.template distance<sizeof...(Views) - 1>(1);
+    }
+
+    // the position of the tuple pointed to by it within every view (outermost first), e.g. to save the state of a long
+    // traversal, which restore() resumes from (the end is the size of the outermost view along with zeros)
+    template <bool propagate_const, typename Parent>
+    requires std::same_as<std::remove_const_t<Parent>, cartesian_product_view>
+    constexpr std::array<difference_type, sizeof...(Views)> checkpoint(cartesian_iterator<propagate_const, Parent> const& it) const {
+        if constexpr (!borrowed) {
+            assert(it.parent == this && "Attempting to checkpoint cartesian_product_view<> with the iterator of another one!");
+        }
+
+        return
+            [&]<std::size_t... indices>(std::index_sequence<indices...>) {
+                return std::array<difference_type, sizeof...(Views)>{ static_cast<difference_type>(std::ranges::distance(it.template first<indices>(), std::get<indices>(it.its)))... };
+            }(std::index_sequence_for<Views...>{})
+        ;
+    }
+
+    // the iterator to the tuple at the given positions within the views, which takes O(sizeof...(Views)) steps for
+    // random-access views (and walks the views up to the positions otherwise)
+    constexpr auto restore(std::array<difference_type, sizeof...(Views)> const& positions) {
+        return restore(*this, positions);
+    }
+
+    constexpr auto restore(std::array<difference_type, sizeof...(Views)> const& positions) const requires (... && std::ranges::range<Views const>) {
+        return restore(*this, positions);
+    }
+
+    // the iterator to the tuple at the flat index n (see index_of())
+    constexpr auto restore(difference_type const n)
+        requires (... && (std::ranges::random_access_range<Views> && std::ranges::sized_range<Views>))
+    {
+        assert(0 <= n && n <= static_cast<difference_type>(size(views)) && "Attempting to restore cartesian_product_view<> iterator out of range!");
+
+        return iterator(false, *this) + n;
+    }
+
+    constexpr auto restore(difference_type const n) const
+        requires (... && (std::ranges::random_access_range<Views const> && std::ranges::sized_range<Views const>))
+    {
+        assert(0 <= n && n <= static_cast<difference_type>(size(views)) && "Attempting to restore cartesian_product_view<> iterator out of range!");
+
+        return iterator(false, *this) + n;
+    }
+
+    // the tuple at the flat index n, located in O(sizeof...(Views)) steps
+    constexpr auto at(difference_type const n)
+        requires (... && (std::ranges::random_access_range<Views> && std::ranges::sized_range<Views>))
+    {
+        return at(*this, n);
+    }
+
+    constexpr auto at(difference_type const n) const
+        requires (... && (std::ranges::random_access_range<Views const> && std::ranges::sized_range<Views const>))
+    {
+        return at(*this, n);
+    }
+
+    // converts each of the flat indices to the positions of the elements within the views (outermost first) at once;
+    // the iterations are independent of each other, so the loop is subject to vectorization
+    constexpr void unrank(
+        std::span<difference_type const> const flat_indices,
+        std::span<std::array<difference_type, sizeof...(Views)>> const positions
+    ) const
+        requires (sizeof...(Views) != 0 && (... && std::ranges::sized_range<Views const>))
+    {
+        assert(flat_indices.size() == positions.size() && "Attempting to unrank into a cartesian_product_view<> position buffer of different size!");
+
+        [&]<std::size_t... indices>(std::index_sequence<indices...>) {
+            constexpr std::size_t innermost = sizeof...(Views) - 1;
+            std::array<difference_type, sizeof...(Views)> const radices{ radix<indices>(views)... };
+#ifndef NDEBUG
+            auto const count = static_cast<difference_type>(size(views));
+#endif
+            for (std::size_t i = 0; i != flat_indices.size(); ++i) {
+                auto n = flat_indices[i];
+                assert(0 <= n && n < count && "Attempting to unrank cartesian_product_view<> index out of range!");
+
+                // the digits of n in the mixed-radix numeral system, starting with the innermost one
+                auto& digits = positions[i];
+                ((digits[innermost - indices] = n % radices[innermost - indices], n /= radices[innermost - indices]), ...);
+            }
+        }(std::index_sequence_for<Views...>{});
+    }
+
+    // n disjoint, contiguous subranges covering the whole product in order, e.g. one for each worker thread;
+    // they are balanced to a single tuple, if all of the views are sized random_access_ranges,
+    // otherwise to a single element of the outermost view (which is walked once)
+    constexpr auto chunks(std::size_t const n) & {
+        return chunks(*this, n);
+    }
+
+    constexpr auto chunks(std::size_t const n) const& requires (... && std::ranges::range<Views const>) {
+        return chunks(*this, n);
+    }
+
+    // the iterators of a temporary product would dangle, unless they keep the beginnings and ends of the views themselves
+    constexpr auto chunks(std::size_t const n) && requires borrowed {
+        return chunks(*this, n);
+    }
+
+    constexpr auto chunks(std::size_t) && requires (!borrowed) = delete;
+
+    // invokes f with every tuple in order, like std::ranges::for_each(), but by means of nested loops over the views
+    // (the innermost one being a plain range-based for loop), so there's no carry to check after each tuple
+    template <typename F>
+    constexpr F for_each(F f) {
+        for_each(*this, f);
+        return f;
+    }
+
+    template <typename F>
+    constexpr F for_each(F f) const requires (... && std::ranges::range<Views const>) {
+        for_each(*this, f);
+        return f;
+    }
+
+    // the tuples grouped by the elements of the outer views: every block is a tuple of the references of those
+    // elements along with the innermost view as a whole, which is a std::span<>, if it's a sized contiguous_range
+    // (so that it can be processed by SIMD-friendly kernels), or a std::ranges::subrange<> of it otherwise
+    // (the blocks are empty, if the innermost view is); they refer to the views, so the product has to outlive them
+    constexpr auto blocks() & requires (sizeof...(Views) != 0) {
+        return blocks(*this);
+    }
+
+    constexpr auto blocks() const& requires (sizeof...(Views) != 0 && (... && std::ranges::range<Views const>)) {
+        return blocks(*this);
+    }
+
+    constexpr auto blocks() && = delete;
+
+    // the product as a sized random-access range whose iterators store the position within every view as an Index
+    // (or as the narrowest unsigned integer type that holds the size of a view of static extent) along with a pointer
+    // to the views, rather than the iterators of the views, e.g. to keep lots of iterators as cursors (the sizes of
+    // the views must be representable by Index); the iterators point to the product, so it has to outlive them
+    template <std::unsigned_integral Index = std::uint32_t>
+    constexpr auto compact() & requires (... && (std::ranges::random_access_range<Views> && std::ranges::sized_range<Views>)) {
+        return compact<Index>(*this);
+    }
+
+    template <std::unsigned_integral Index = std::uint32_t>
+    constexpr auto compact() const& requires (... && (std::ranges::random_access_range<Views const> && std::ranges::sized_range<Views const>)) {
+        return compact<Index>(*this);
+    }
+
+    template <std::unsigned_integral Index = std::uint32_t>
+    constexpr auto compact() && = delete;
+
+    // the product as a forward range in reflected (boustrophedon) order: the innermost view is traversed forwards,
+    // then backwards for the next element of the view outside it, and so on, so exactly one element changes per step;
+    // the iterators tell which one by changed() and visit_change(f), for consumers that maintain incremental state
+    constexpr auto reflected() & requires (sizeof...(Views) != 0 && (... && std::ranges::bidirectional_range<Views>)) {
+        return reflected(*this);
+    }
+
+    constexpr auto reflected() const& requires (sizeof...(Views) != 0 && (... && std::ranges::bidirectional_range<Views const>)) {
+        return reflected(*this);
+    }
+
+    // the iterators of a temporary product would dangle, unless they keep the beginnings and ends of the views themselves
+    constexpr auto reflected() && requires (borrowed && sizeof...(Views) != 0 && (... && std::ranges::bidirectional_range<Views>)) {
+        return reflected(*this);
+    }
+
+    constexpr auto reflected() && requires (!borrowed) = delete;
+
+    // the product traversed with the views in the given order, from the outermost (slowest-varying) to the innermost
+    // (fastest-varying) one, e.g. ordered<1, 0>() for the column-major traversal of two views, while the tuples keep
+    // the order of the views (a random access range, if the product is one); it refers to the views of the product,
+    // unless the product is a temporary, whose views are moved into it
+    template <std::size_t... order>
+    constexpr auto ordered() & requires (sizeof...(Views) != 0 && permutation<order...>()) {
+        return ordered<order...>(*this);
+    }
+
+    template <std::size_t... order>
+    constexpr auto ordered() const& requires (sizeof...(Views) != 0 && permutation<order...>() && (... && std::ranges::range<Views const>)) {
+        return ordered<order...>(*this);
+    }
+
+    template <std::size_t... order>
+    constexpr auto ordered() && requires (sizeof...(Views) != 0 && permutation<order...>()) {
+        using reference = std::iter_reference_t<decltype(iterator(false, *this))>;
+        return reorder<order...>(std::type_identity<reference>{}, std::move(std::get<order>(views))...);
+    }
+
+private:
+    template <typename T>
+    static constexpr auto iterator(bool const begin_end, T& self) {
+        return
+            cartesian_iterator<
+                deep_const && std::is_const_v<T>,
+                T
+            > {
+                begin_end
+             || std::apply(
+                    [](auto&... views) {
+                        return (... || std::ranges::empty(views));
+                    },
+                    self.views
+                ),
+                &self
+            }
+        ;
+    }
+
+    template <typename T>
+    static constexpr auto partition(T& self, difference_type const first, difference_type const last) {
+        assert(0 <= first && first <= last && last <= static_cast<difference_type>(size(self.views)) && "Attempting to partition cartesian_product_view<> out of range!");
+
+        auto const begin = iterator(false, self);
+        return std::ranges::subrange{ begin + first, begin + last };
+    }
+
+    template <typename T>
+    static constexpr auto restore(T& self, std::array<difference_type, sizeof...(Views)> const& positions) {
+        assert(std::ranges::all_of(positions, [](auto const position) { return 0 <= position; }) && "Attempting to restore cartesian_product_view<> iterator out of range!");
+
+        using iterator_type = decltype(iterator(false, self));
+        return
+            [&]<std::size_t... indices>(std::index_sequence<indices...>) {
+                typename iterator_type::iterators its{ std::ranges::begin(std::get<indices>(self.views))... };
+
+                // the views are walked up to their ends at most, however far out of range the positions are
+                [[maybe_unused]] std::array<bool, sizeof...(Views)> const reached{
+                    std::ranges::advance(
+                        std::get<indices>(its),
+                        static_cast<std::ranges::range_difference_t<decltype(std::get<indices>(self.views))>>(positions[indices]),
+                        std::ranges::end(std::get<indices>(self.views))
+                    ) == 0 ...
+                };
+                assert(std::ranges::all_of(reached, std::identity{}) && "Attempting to restore cartesian_product_view<> iterator out of range!");
+
+                if constexpr (sizeof...(Views) != 0) {
+                    // only the end of the product is at the end of a view: the end of the outermost view along with the beginnings of the others
+                    assert(
+                        (
+                            std::get<0>(its) == std::ranges::end(std::get<0>(self.views))
+                          ? std::ranges::all_of(positions | std::views::drop(1), [](auto const position) { return position == 0; })
+                          : (... && (std::get<indices>(its) != std::ranges::end(std::get<indices>(self.views))))
+                        )
+                     && "Attempting to restore cartesian_product_view<> iterator out of range!"
+                    );
+                }
+
+                return iterator_type{ std::move(its), &self };
+            }(std::index_sequence_for<Views...>{})
+        ;
+    }
+
+    template <typename T>
+    static constexpr auto at(T& self, difference_type const n) {
+        if (n < 0 || n >= static_cast<difference_type>(size(self.views))) {
+            throw std::out_of_range{ "Attempting to access cartesian_product_view<> out of range!" };
+        }
+
+        return *(iterator(false, self) + n);
+    }
+
+    template <typename T>
+    static constexpr auto chunks(T& self, std::size_t const n) {
+        assert(n != 0 && "Attempting to split cartesian_product_view<> into zero chunks!");
+
+        using iterator_type = decltype(iterator(false, self));
+
+        std::vector<std::ranges::subrange<iterator_type>> chunks{};
+        chunks.reserve(n);
+
+        auto const end = iterator(true, self);
+        auto first = iterator(false, self);
+        if constexpr (std::random_access_iterator<iterator_type>) {
+            auto const size = end - first;
+            auto const count = static_cast<difference_type>(n);
+            for (difference_type i = 0; i != count; ++i) {
+                auto last = first + (size / count + (i < size % count));
+                chunks.emplace_back(first, last);
+                first = std::move(last);
+            }
+        } else if (first == end) {
+            chunks.resize(n, { first, end });
+        } else {
+            auto& outermost = std::get<0>(self.views);
+            auto const size = static_cast<std::size_t>(std::ranges::distance(outermost));
+            auto it = std::ranges::begin(outermost);
+            for (std::size_t i = 0; i != n; ++i) {
+                std::ranges::advance(it, static_cast<std::ranges::range_difference_t<decltype(outermost)>>(size / n + (i < size % n)));
+                auto last =
+                    iterator_type{
+                        std::apply(
+                            [&](auto&, auto&... views) {
+                                return typename iterator_type::iterators{ it, std::ranges::begin(views)... };
+                            },
+                            self.views
+                        ),
+                        &self
+                    }
+                ;
+                chunks.emplace_back(first, last);
+                first = std::move(last);
+            }
+        }
+
+        return chunks;
+    }
+
+    template <typename Index, typename T>
+    static constexpr auto compact(T& self) {
+        assert(
+            std::apply(
+                [](auto&... views) {
+                    return (... && (std::ranges::size(views) <= std::numeric_limits<Index>::max()));
+                },
+                self.views
+            )
+         && "Attempting to index cartesian_product_view<> compactly with too narrow an integer type!"
+        );
+
+        using iterator_type = compact_iterator<Index, deep_const && std::is_const_v<T>, T>;
+        return std::ranges::subrange{ iterator_type{ false, &self }, iterator_type{ true, &self } };
+    }
+
+    template <typename T>
+    static constexpr auto reflected(T& self) {
+        using iterator_type = reflected_iterator<deep_const && std::is_const_v<T>, T>;
+        auto const empty = std::apply([](auto&... views) { return (... || std::ranges::empty(views)); }, self.views);
+        return std::ranges::subrange{ iterator_type{ empty, &self }, iterator_type{ true, &self } };
+    }
+
+    template <std::size_t... order, typename T>
+    static constexpr auto ordered(T& self) {
+        using reference = std::iter_reference_t<decltype(iterator(false, self))>;
+        return reorder<order...>(std::type_identity<reference>{}, std::ranges::ref_view{ std::get<order>(self.views) }...);
+    }
+
+    // the product of the views given in traversal order, whose tuples are rearranged into the order of Views
+    template <std::size_t... order, typename Reference, typename... Permuted>
+    static constexpr auto reorder(std::type_identity<Reference>, Permuted... permuted_views) {
+        return
+            cartesian_product_view<
+                false, // const is propagated by the conversion to reference below
+                Permuted...
+            > {
+                std::move(permuted_views)...
+            }
+          | std::views::transform(
+                [](auto const& permuted) -> Reference {
+                    return
+                        [&]<std::size_t... indices>(std::index_sequence<indices...>) {
+                            return Reference{ static_cast<std::tuple_element_t<indices, Reference>>(std::get<rank<order...>(indices)>(permuted))... };
+                        }(std::index_sequence_for<Views...>{})
+                    ;
+                }
+            )
+        ;
+    }
+
+    template <typename T>
+    static constexpr auto blocks(T& self) {
+        using reference = std::iter_reference_t<decltype(iterator(false, self))>;
+        constexpr auto innermost = sizeof...(Views) - 1;
+
+        auto block =
+            [&] {
+                using element_t = std::tuple_element_t<innermost, reference>;
+                auto& view = std::get<innermost>(self.views);
+                if constexpr (std::ranges::contiguous_range<decltype(view)> && std::ranges::sized_range<decltype(view)>) {
+                    return std::span<std::remove_reference_t<element_t>>{ std::ranges::data(view), std::ranges::size(view) };
+                } else if constexpr (std::same_as<element_t, std::ranges::range_reference_t<decltype(view)>>) {
+                    return std::ranges::subrange{ view };
+                } else {
+                    return
+                        std::ranges::subrange{ view }
+                      | std::views::transform(
+                            [](auto&& element) -> element_t {
+                                return static_cast<element_t>(element);
+                            }
+                        )
+                    ;
+                }
+            }()
+        ;
+
+        return
+            [&]<std::size_t... indices>(std::index_sequence<indices...>) {
+                using block_reference = std::tuple<std::tuple_element_t<indices, reference>..., decltype(block)>;
+                if constexpr (sizeof...(indices) == 0) {
+                    return std::views::single(block_reference{ std::move(block) });
+                } else {
+                    return
+                        cartesian_product_view<
+                            false, // const is propagated by the conversion to reference below
+                            std::ranges::ref_view<std::remove_reference_t<decltype(std::get<indices>(self.views))>>...
+                        > {
+                            std::ranges::ref_view<std::remove_reference_t<decltype(std::get<indices>(self.views))>>{ std::get<indices>(self.views) }...
+                        }
+                      | std::views::transform(
+                            [block = std::move(block)](auto const& outer) -> block_reference {
+                                return block_reference{ static_cast<std::tuple_element_t<indices, reference>>(std::get<indices>(outer))..., block };
+                            }
+                        )
+                    ;
+                }
+            }(std::make_index_sequence<innermost>{})
+        ;
+    }
+
+    template <typename T, typename F>
+    static constexpr void for_each(T& self, F& f) {
+        if constexpr (sizeof...(Views) != 0) {
+            for_each<0, std::iter_reference_t<decltype(iterator(false, self))>>(self.views, f);
+        }
+    }
+
+    // the elements of the outer views are passed down as lvalues, since they are used for many tuples,
+    // and are converted to the element types of Reference (i.e. copied, if those aren't references) per tuple
+    template <std::size_t index, typename Reference, typename ViewsTuple, typename F, typename... Elements>
+    static constexpr void for_each(ViewsTuple& views, F& f, Elements&... elements) {
+        if constexpr (index == sizeof...(Views)) {
+            [&]<std::size_t... indices>(std::index_sequence<indices...>) {
+                std::invoke(f, Reference{ static_cast<std::tuple_element_t<indices, Reference>>(elements)... });
+            }(std::index_sequence_for<Elements...>{});
+        } else {
+            for (auto&& element : std::get<index>(views)) {
+                for_each<index + 1, Reference>(views, f, elements..., element);
+            }
+        }
+    }
+
+    template <typename T>
+    static constexpr size_type size(T& views) {
+        assert(checked_size(views) && "Attempting to size cartesian_product_view<> whose size overflows!");
+
+        return
+            std::apply(
+                [](auto&... views) {
+                    return (size_type{ sizeof...(views) != 0 } * ... * static_cast<size_type>(std::ranges::size(views)));
+                },
+                views
+            )
+        ;
+    }
+
+    template <typename T>
+    static constexpr std::optional<size_type> checked_size(T& views) {
+        return
+            checked_product(
+                std::apply(
+                    [](auto&... views) {
+                        return std::array<size_type, sizeof...(Views)>{ static_cast<size_type>(std::ranges::size(views))... };
+                    },
+                    views
+                )
+            )
+        ;
+    }
+
+    static constexpr std::optional<size_type> checked_product(std::array<size_type, sizeof...(Views)> const& radices) {
+        // an empty view makes the whole product empty, however big the rest is
+        if (radices.empty() || std::ranges::find(radices, size_type{ 0 }) != radices.end()) {
+            return size_type{ 0 };
+        }
+
+        constexpr auto max = static_cast<size_type>(-1) >> 1;
+        size_type size = 1;
+        for (auto const radix : radices) {
+            if (size > max / radix) {
+                return std::nullopt;
+            }
+            size *= radix;
+        }
+
+        return size;
+    }
+
+    // a compile-time constant for views of static extent, which turns the divisions of unranking into multiplications
+    template <std::size_t index, typename T>
+    static constexpr difference_type radix(T& views) {
+        if constexpr (constexpr auto extent = static_extent<std::tuple_element_t<index, std::tuple<Views...>>>::value; extent != std::dynamic_extent) {
+            return static_cast<difference_type>(extent);
+        } else {
+            return static_cast<difference_type>(std::ranges::ssize(std::get<index>(views)));
+        }
+    }
+
+    template <std::size_t index>
+    constexpr auto end_iterator() {
+        return std::get<index>(end_iterators).get(std::get<index>(views));
+    }
+
+    template <std::size_t index>
+    constexpr auto end_iterator() const {
+        return std::get<index>(const_end_iterators).get(std::get<index>(views));
+    }
+
+    // reads the views themselves to reduce the product separably
+    friend struct cartesian_reduce_fn;
+
+    std::tuple<Views...> views;
+    mutable std::tuple<end_cache<Views>...> end_iterators{};
+    mutable std::tuple<end_cache<Views const>...> const_end_iterators{};
+};
+
+template <typename... Ranges>
+cartesian_product_view(Ranges&&...) -> cartesian_product_view<true, std::views::all_t<Ranges>...>;
+
+template <bool deep_const, typename... Views>
+inline constexpr bool std::ranges::enable_borrowed_range<cartesian_product_view<deep_const, Views...>> = (... && std::ranges::enable_borrowed_range<Views>);
+
+// defined in cached_cartesian_product_view.h, which has to be included to stream input ranges through cartesian_product
+struct cached_cartesian_product_fn;
+
+// the amount of heap memory the inner ranges of a cached_cartesian_product_view<> are buffered in,
+// beyond which the buffers are placed in memory-mapped temporary files
+struct cartesian_memory_limit {
+    std::size_t bytes;
+};
+
+template <bool deep_const>
+struct cartesian_product_fn {
+    template <typename... Ranges>
+    requires (... && (std::ranges::forward_range<Ranges> && std::ranges::viewable_range<Ranges>))
+    constexpr auto operator()(Ranges&&... ranges) const {
+        return cartesian_product_view<deep_const, std::views::all_t<Ranges>...>{ std::views::all(std::forward<Ranges>(ranges))... };
+    }
+
+    // an outermost range that can be read only once (e.g. a stream) is streamed, while the inner ranges are buffered
+    // (see cached_cartesian_product_view<> in cached_cartesian_product_view.h)
+    template <typename Outer, typename... Inners>
+    requires (
+        sizeof...(Inners) != 0
+     && !std::ranges::forward_range<Outer> && std::ranges::input_range<Outer> && std::ranges::viewable_range<Outer>
+     && (... && (std::ranges::input_range<Inners> && std::ranges::viewable_range<Inners>))
+    )
+    auto operator()(Outer&& outer, Inners&&... inners) const {
+        return cached(std::forward<Outer>(outer), std::forward<Inners>(inners)...);
+    }
+
+    template <typename Outer, typename... Inners>
+    requires (
+        sizeof...(Inners) != 0
+     && std::ranges::input_range<Outer> && std::ranges::viewable_range<Outer>
+     && (... && (std::ranges::input_range<Inners> && std::ranges::viewable_range<Inners>))
+    )
+    auto operator()(cartesian_memory_limit const limit, Outer&& outer, Inners&&... inners) const {
+        return cached(limit, std::forward<Outer>(outer), std::forward<Inners>(inners)...);
+    }
+
+private:
+    // the dependent Fn defers the lookup of cached_cartesian_product_fn's definition until the overloads above are used
+    template <typename Fn = cached_cartesian_product_fn, typename... Args>
+    static auto cached(Args&&... args) {
+        static_assert(requires { sizeof(Fn); }, "Include cached_cartesian_product_view.h to stream input ranges through cartesian_product!");
+        return Fn{}(std::forward<Args>(args)...);
+    }
+};
+
+inline constexpr cartesian_product_fn<true> cartesian_product{};
+
+// The tuples of a cartesian_product_view<> whose prefixes satisfy the corresponding predicates: the k-th predicate is
+// invoked with the first k + 1 elements of a tuple (the ones of the innermost views may be omitted), and once it rejects
+// a prefix, all of the tuples sharing it are skipped in a single step, which turns exhaustive scans into branch and bound
+template <typename Product, typename... Predicates>
+class filtered_cartesian_product_view final : public std::ranges::view_base {
+    using base_iterator = std::ranges::iterator_t<Product>;
+
+    static constexpr std::size_t innermost = std::tuple_size_v<std::iter_value_t<base_iterator>> - 1;
+
+    class iterator {
+        friend filtered_cartesian_product_view;
+
+    public:
+        using iterator_category = std::input_iterator_tag;
+        using iterator_concept  = std::forward_iterator_tag;
+        using difference_type   = std::iter_difference_t<base_iterator>;
+        using value_type        = std::iter_value_t<base_iterator>;
+        using reference         = std::iter_reference_t<base_iterator>;
+
+        iterator() = default;
+
+        // it has to satisfy the predicates already (or be the end)
+        constexpr iterator(base_iterator it, filtered_cartesian_product_view const* parent)
+            : it{ std::move(it) }
+            , parent{ parent }
+        {}
+
+        constexpr iterator& operator++() {
+            satisfy(it.skip_suffix(innermost));
+            return *this;
+        }
+
+        constexpr iterator operator++(int) {
+            auto ret = *this;
+            ++*this;
+            return ret;
+        }
+
+        constexpr reference operator*() const {
+            return *it;
+        }
+
+        constexpr bool operator==(iterator const& other) const {
+            return it == other.it;
+        }
+
+        constexpr bool operator==(std::default_sentinel_t) const {
+            return it == std::default_sentinel;
+        }
+
+    private:
+        // checks the predicates from level inwards (the outer ones are satisfied by the unchanged prefix),
+        // skipping the tuples of every rejected prefix
+        constexpr void satisfy(std::size_t level) {
+            while (level < sizeof...(Predicates) && it != std::default_sentinel) {
+                level = accepts(level) ? level + 1 : it.skip_suffix(level);
+            }
+        }
+
+        constexpr bool accepts(std::size_t const level) const {
+            auto const tuple = *it;
+            return
+                [&]<std::size_t... levels>(std::index_sequence<levels...>) {
+                    bool accepted = true;
+                    static_cast<void>((... || (levels == level && (accepted = accepts<levels>(tuple), true))));
+                    return accepted;
+                }(std::index_sequence_for<Predicates...>{})
+            ;
+        }
+
+        template <std::size_t level, typename Tuple>
+        constexpr bool accepts(Tuple const& tuple) const {
+            return
+                [&]<std::size_t... indices>(std::index_sequence<indices...>) {
+                    return static_cast<bool>(std::invoke(std::get<level>(*parent->predicates), std::get<indices>(tuple)...));
+                }(std::make_index_sequence<level + 1>{})
+            ;
+        }
+
+        base_iterator it{};
+        filtered_cartesian_product_view const* parent{};
+    };
+
+public:
+    filtered_cartesian_product_view() = default;
+
+    constexpr filtered_cartesian_product_view(Product& product, Predicates... predicates)
+        : product{ &product }
+        , predicates{ std::tuple<Predicates...>{ std::move(predicates)... } }
+    {}
+
+    constexpr auto begin() const {
+        return
+            iterator{
+                first.get(
+                    [&] {
+                        iterator it{ std::ranges::begin(*product), this };
+                        it.satisfy(0);
+                        return std::move(it.it);
+                    }
+                ),
+                this
+            }
+        ;
+    }
+
+    constexpr auto end() const {
+        return iterator{ std::ranges::end(*product), this };
+    }
+
+private:
+    Product* product{};
+    cartesian_detail::assignable_box<std::tuple<Predicates...>> predicates{};
+
+    // the first tuple that satisfies the predicates, which takes the whole pruned search up to it to find, so it's
+    // searched for on the first call to begin() and is reused afterwards (as by std::ranges::filter_view<>)
+    mutable cartesian_detail::lazy_cache<base_iterator> first{};
+};
+
+struct filtered_cartesian_product_fn {
+    template <typename Product, typename... Predicates>
+    requires (
+        sizeof...(Predicates) <= std::tuple_size_v<std::ranges::range_value_t<Product>>
+     && requires (std::ranges::iterator_t<Product>& it) { { it.skip_suffix(std::size_t{}) } -> std::convertible_to<std::size_t>; }
+    )
+    constexpr auto operator()(Product& product, Predicates... predicates) const {
+        return filtered_cartesian_product_view<Product, Predicates...>{ product, std::move(predicates)... };
+    }
+};
+
+inline constexpr filtered_cartesian_product_fn filtered_cartesian_product{};
+
+// The separable reductions of cartesian_reduce(): each of them accumulates a function of the tuples (by invoking it
+// as op(accumulator, tuple)), but can be evaluated by separately() from the elements of the views as well, as every
+// element of a view is part of the same number of tuples (the size of the product divided by the size of the view).
+namespace cartesian_reduction {
+    namespace detail {
+        template <typename T, typename Tuple>
+        constexpr T sum(Tuple const& tuple) {
+            return std::apply([](auto const&... elements) { return (T{} + ... + static_cast<T>(elements)); }, tuple);
+        }
+
+        // the number of tuples every element of the views is part of
+        template <typename... Ranges>
+        constexpr std::array<std::uintmax_t, sizeof...(Ranges)> multiplicities(Ranges&... ranges) {
+            std::array<std::uintmax_t, sizeof...(Ranges)> const sizes{ static_cast<std::uintmax_t>(std::ranges::distance(ranges))... };
+            std::array<std::uintmax_t, sizeof...(Ranges)> multiplicities{};
+            for (std::size_t i = 0; i != sizes.size(); ++i) {
+                multiplicities[i] = 1;
+                for (std::size_t j = 0; j != sizes.size(); ++j) {
+                    multiplicities[i] *= i != j ? sizes[j] : 1;
+                }
+            }
+
+            return multiplicities;
+        }
+
+        // x multiplied by itself n times (1 for n == 0) by means of repeated squaring
+        template <typename T>
+        constexpr T power(T x, std::uintmax_t n) {
+            T result{ 1 };
+            for (; n != 0; n >>= 1) {
+                if (n & 1) {
+                    result *= x;
+                }
+                x *= x;
+            }
+
+            return result;
+        }
+    }
+
+    // accumulator + the sum of the elements of every tuple
+    struct sum {
+        template <typename T, typename Tuple>
+        constexpr T operator()(T accumulator, Tuple const& tuple) const {
+            return std::move(accumulator) + detail::sum<T>(tuple);
+        }
+
+        template <typename T, typename... Ranges>
+        constexpr T separately(T accumulator, Ranges&... ranges) const {
+            auto const multiplicities = detail::multiplicities(ranges...);
+            std::size_t index = 0;
+            (..., [&] {
+                T sum{};
+                for (auto&& element : ranges) {
+                    sum += static_cast<T>(element);
+                }
+                accumulator += sum * static_cast<T>(multiplicities[index++]);
+            }());
+
+            return accumulator;
+        }
+    };
+
+    // accumulator * the product of the elements of every tuple
+    struct product {
+        template <typename T, typename Tuple>
+        constexpr T operator()(T accumulator, Tuple const& tuple) const {
+            return std::apply([&](auto const&... elements) { return (std::move(accumulator) * ... * static_cast<T>(elements)); }, tuple);
+        }
+
+        template <typename T, typename... Ranges>
+        constexpr T separately(T accumulator, Ranges&... ranges) const {
+            auto const multiplicities = detail::multiplicities(ranges...);
+            std::size_t index = 0;
+            (..., [&] {
+                T product{ 1 };
+                for (auto&& element : ranges) {
+                    product *= static_cast<T>(element);
+                }
+                accumulator *= detail::power(product, multiplicities[index++]);
+            }());
+
+            return accumulator;
+        }
+    };
+
+    // the least of accumulator and the elements of every tuple
+    struct min {
+        template <typename T, typename Tuple>
+        constexpr T operator()(T accumulator, Tuple const& tuple) const {
+            std::apply([&](auto const&... elements) { ((accumulator = std::min(accumulator, static_cast<T>(elements))), ...); }, tuple);
+            return accumulator;
+        }
+
+        // every element is part of a tuple, unless the product is empty
+        template <typename T, typename... Ranges>
+        constexpr T separately(T accumulator, Ranges&... ranges) const {
+            if ((... || std::ranges::empty(ranges))) {
+                return accumulator;
+            }
+
+            (..., std::ranges::for_each(ranges, [&](auto const& element) { accumulator = std::min(accumulator, static_cast<T>(element)); }));
+            return accumulator;
+        }
+    };
+
+    // the greatest of accumulator and the elements of every tuple
+    struct max {
+        template <typename T, typename Tuple>
+        constexpr T operator()(T accumulator, Tuple const& tuple) const {
+            std::apply([&](auto const&... elements) { ((accumulator = std::max(accumulator, static_cast<T>(elements))), ...); }, tuple);
+            return accumulator;
+        }
+
+        template <typename T, typename... Ranges>
+        constexpr T separately(T accumulator, Ranges&... ranges) const {
+            if ((... || std::ranges::empty(ranges))) {
+                return accumulator;
+            }
+
+            (..., std::ranges::for_each(ranges, [&](auto const& element) { accumulator = std::max(accumulator, static_cast<T>(element)); }));
+            return accumulator;
+        }
+    };
+
+    // counts the tuples by the sum of their elements in a map-like accumulator (e.g. std::map<sum, count>): the
+    // distribution of the sums is the convolution of the distributions of the views, computed one view at a time
+    struct sum_histogram {
+        template <typename Map, typename Tuple>
+        constexpr Map operator()(Map accumulator, Tuple const& tuple) const {
+            ++accumulator[detail::sum<typename Map::key_type>(tuple)];
+            return accumulator;
+        }
+
+        template <typename Map, typename... Ranges>
+        constexpr Map separately(Map accumulator, Ranges&... ranges) const {
+            using key_type = typename Map::key_type;
+            using mapped_type = typename Map::mapped_type;
+
+            Map distribution{};
+            if constexpr (sizeof...(Ranges) != 0) {
+                distribution.emplace(key_type{}, mapped_type{ 1 });
+            }
+
+            (..., [&] {
+                Map convolution{};
+                for (auto const& [sum, count] : distribution) {
+                    for (auto&& element : ranges) {
+                        convolution[sum + static_cast<key_type>(element)] += count;
+                    }
+                }
+                distribution = std::move(convolution);
+            }());
+
+            for (auto const& [sum, count] : distribution) {
+                accumulator[sum] += count;
+            }
+
+            return accumulator;
+        }
+    };
+}
+
+// Reduces the tuples of a cartesian_product_view<> by init = op(std::move(init), tuple). If op can be evaluated
+// separably (i.e. it has a separately(init, views...) member function, as the reductions of cartesian_reduction do),
+// the views are reduced one by one instead, which takes O(the sum of their sizes) rather than O(their product) steps
+// (or O(number of views * the size of the views * the number of distinct sums) for sum_histogram); otherwise the
+// tuples are enumerated by for_each().
+struct cartesian_reduce_fn {
+    template <bool deep_const, typename... Views, typename Op, typename T>
+    constexpr T operator()(cartesian_product_view<deep_const, Views...>& cpv, Op op, T init) const {
+        return reduce(cpv, op, std::move(init));
+    }
+
+    template <bool deep_const, typename... Views, typename Op, typename T>
+    constexpr T operator()(cartesian_product_view<deep_const, Views...> const& cpv, Op op, T init) const {
+        return reduce(cpv, op, std::move(init));
+    }
+
+private:
+    template <typename Op, typename T, typename ViewsTuple>
+    struct separable : std::false_type {};
+
+    template <typename Op, typename T, typename... Views>
+    struct separable<Op, T, std::tuple<Views...>>
+        : std::bool_constant<requires (Op& op, T init, Views&... views) { op.separately(std::move(init), views...); }>
+    {};
+
+    template <typename Op, typename T, typename... Views>
+    struct separable<Op, T, std::tuple<Views...> const>
+        : std::bool_constant<requires (Op& op, T init, Views const&... views) { op.separately(std::move(init), views...); }>
+    {};
+
+    template <typename Product, typename Op, typename T>
+    static constexpr T reduce(Product& cpv, Op& op, T init) {
+        if constexpr (separable<Op, T, std::remove_reference_t<decltype(cpv.views)>>::value) {
+            return std::apply([&](auto&... views) { return op.separately(std::move(init), views...); }, cpv.views);
+        } else {
+            cpv.for_each(
+                [&](auto const& tuple) {
+                    init = std::invoke(op, std::move(init), tuple);
+                }
+            );
+
+            return init;
+        }
+    }
+};
+
+inline constexpr cartesian_reduce_fn cartesian_reduce{};
+
+// Invokes f(accumulator, tuple) for every tuple of a cartesian_product_view<> on thread_count threads
+// (the calling one included), each of which starts with its own copies of f and of identity as accumulator,
+// then merges the accumulators by reducer(T, T) -> T and returns the result.
+// Without an identity, f(tuple) -> T is folded into the accumulators by reducer instead, starting from T{}.
+// The product is dealt out to the threads by chunks(); if random access is available, each chunk is
+// halved recursively on demand (the halves are queued), otherwise the chunks are split along the outermost view only.
+// Idle threads steal the largest queued chunks of the others, so that skewed costs per tuple even out.
+// The first exception thrown by f stops the processing and is rethrown after every thread has been joined.
+struct cartesian_parallel_for_each_fn {
+    template <typename R, typename F, typename Reducer, typename T>
+    requires requires (R& r) { r.chunks(std::size_t{}); }
+    T operator()(
+        R&& cpv,
+        F f,
+        Reducer reducer,
+        T identity,
+        std::size_t const thread_count = std::max(1u, std::thread::hardware_concurrency())
+    ) const {
+        assert(thread_count != 0 && "Attempting to iterate cartesian_product_view<> on zero threads!");
+
+        using iterator_type = std::ranges::iterator_t<R>;
+        using chunk_type = std::ranges::subrange<iterator_type>;
+        constexpr bool splittable = std::random_access_iterator<iterator_type>;
+
+        struct worker {
+            worker(F function, T accumulator)
+                : function{ std::move(function) }
+                , accumulator{ std::move(accumulator) }
+            {}
+
+            std::mutex mutex{};
+            std::deque<chunk_type> chunks{};
+            F function;
+            T accumulator;
+        };
+
+        std::deque<worker> workers{};
+        std::atomic<std::size_t> pending{};
+        std::atomic<bool> failed{};
+        std::exception_ptr exception{};
+        std::mutex exception_mutex{};
+
+        auto const chunks = cpv.chunks(splittable ? thread_count : 8 * thread_count);
+        for (std::size_t i = 0; i != thread_count; ++i) {
+            workers.emplace_back(f, identity);
+        }
+        for (std::size_t i = 0; i != chunks.size(); ++i) {
+            if (!chunks[i].empty()) {
+                workers[i % thread_count].chunks.push_back(chunks[i]);
+                ++pending;
+            }
+        }
+
+        auto const take =
+            [&](std::size_t const self) -> std::optional<chunk_type> {
+                while (!failed && pending != 0) {
+                    for (std::size_t i = 0; i != thread_count; ++i) {
+                        auto& victim = workers[(self + i) % thread_count];
+                        std::scoped_lock const lock{ victim.mutex };
+                        if (victim.chunks.empty()) {
+                            continue;
+                        }
+
+                        // the own chunks are taken LIFO, the stolen ones FIFO (i.e. the largest ones first)
+                        std::optional<chunk_type> chunk{};
+                        if (i == 0) {
+                            chunk.emplace(std::move(victim.chunks.back()));
+                            victim.chunks.pop_back();
+                        } else {
+                            chunk.emplace(std::move(victim.chunks.front()));
+                            victim.chunks.pop_front();
+                        }
+                        return chunk;
+                    }
+
+                    std::this_thread::yield();
+                }
+
+                return std::nullopt;
+            }
+        ;
+
+        auto const work =
+            [&](std::size_t const self) {
+                auto& function = workers[self].function;
+                auto& accumulator = workers[self].accumulator;
+                try {
+                    while (auto chunk = take(self)) {
+                        if constexpr (splittable) {
+                            using difference_type = std::iter_difference_t<iterator_type>;
+                            auto const grain = std::max(std::ranges::distance(cpv) / static_cast<difference_type>(256 * thread_count), difference_type{ 1 });
+                            while (std::ranges::ssize(*chunk) > grain) {
+                                auto const middle = chunk->begin() + std::ranges::ssize(*chunk) / 2;
+                                ++pending;
+                                {
+                                    std::scoped_lock const lock{ workers[self].mutex };
+                                    workers[self].chunks.emplace_back(middle, chunk->end());
+                                }
+                                chunk.emplace(chunk->begin(), middle);
+                            }
+                        }
+
+                        for (auto&& tuple : *chunk) {
+                            std::invoke(function, accumulator, std::forward<decltype(tuple)>(tuple));
+                        }
+
+                        --pending;
+                    }
+                } catch (...) {
+                    std::scoped_lock const lock{ exception_mutex };
+                    if (!exception) {
+                        exception = std::current_exception();
+                    }
+                    failed = true;
+                }
+            }
+        ;
+
+        {
+            std::vector<std::jthread> threads{};
+            threads.reserve(thread_count - 1);
+            for (std::size_t i = 1; i != thread_count; ++i) {
+                threads.emplace_back(work, i);
+            }
+
+            work(0);
+        }
+
+        if (exception) {
+            std::rethrow_exception(exception);
+        }
+
+        auto result = std::move(workers.front().accumulator);
+        for (auto& worker : workers | std::views::drop(1)) {
+            result = std::invoke(reducer, std::move(result), std::move(worker.accumulator));
+        }
+
+        return result;
+    }
+
+    template <
+        typename R,
+        typename F,
+        typename Reducer,
+        typename T = std::remove_cvref_t<std::invoke_result_t<F&, std::ranges::range_reference_t<R>>>
+    >
+    requires requires (R& r) { r.chunks(std::size_t{}); } && std::default_initializable<T>
+    T operator()(R&& cpv, F f, Reducer reducer) const {
+        return
+            (*this)(
+                cpv,
+                [f = std::move(f), reducer](T& accumulator, auto&& tuple) mutable {
+                    accumulator = std::invoke(reducer, std::move(accumulator), std::invoke(f, std::forward<decltype(tuple)>(tuple)));
+                },
+                reducer,
+                T{}
+            )
+        ;
+    }
+};
+
+inline constexpr cartesian_parallel_for_each_fn cartesian_parallel_for_each{};
 
 #endif
\ No newline at end of file
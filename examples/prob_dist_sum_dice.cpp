@@ -1,4 +1,5 @@
 #include <algorithm>
+#include <functional>
 #include <iostream>
 #include <map>
 #include <numeric>
@@ -44,20 +45,9 @@ auto prob_dist_sum_dice() {
         }(std::make_index_sequence<dice_count>{})
     ;
 
-    std::map<std::size_t, std::size_t> distribution{};
-    std::ranges::for_each(
-        tuples,
-        [&](auto const& tuple) {
-            ++distribution[
-                std::apply(
-                    [](auto const... elements) {
-                        return (std::size_t{} + ... + elements);
-                    },
-                    tuple
-                )
-            ];
-        }
-    );
+    // the distribution of the sums is the convolution of the distributions of the dice, which cartesian_reduce()
+    // computes one die at a time instead of enumerating all of the 6^dice_count tuples
+    auto distribution = cartesian_reduce(tuples, cartesian_reduction::sum_histogram{}, std::map<std::size_t, std::size_t>{});
 
     return std::pair{ accumulate(distribution | std::views::values), std::move(distribution) };
 }
@@ -0,0 +1,111 @@
+#include <algorithm>
+#include <cstddef>
+#include <execution>
+#include <iostream>
+#include <numeric>
+#include <thread>
+#include <vector>
+
+#include "../cartesian_product_view.h"
+
+template <std::size_t dice_count>
+auto dice_tuples() {
+    static std::size_t dice[]{ 1, 2, 3, 4, 5, 6 };
+    return
+        [&]<std::size_t... indices>(std::index_sequence<indices...>) {
+            return cartesian_product((static_cast<void>(indices), dice)...);
+        }(std::make_index_sequence<dice_count>{})
+    ;
+}
+
+void count_sum(auto const& tuple, std::vector<std::size_t>& distribution) {
+    ++distribution[
+        std::apply(
+            [](auto const... elements) {
+                return (std::size_t{} + ... + elements);
+            },
+            tuple
+        )
+    ];
+}
+
+void count_sums(auto&& tuples, std::vector<std::size_t>& distribution) {
+    for (auto const& tuple : tuples) {
+        count_sum(tuple, distribution);
+    }
+}
+
+template <std::size_t dice_count>
+auto prob_dist_sum_dice_serial() {
+    std::vector<std::size_t> distribution(6 * dice_count + 1);
+    count_sums(dice_tuples<dice_count>(), distribution);
+    return distribution;
+}
+
+template <std::size_t dice_count>
+auto prob_dist_sum_dice_parallel() {
+    auto tuples = dice_tuples<dice_count>();
+    auto const chunks = tuples.chunks(4 * std::max(1u, std::thread::hardware_concurrency()));
+
+    return
+        std::transform_reduce(
+            std::execution::par,
+            chunks.begin(),
+            chunks.end(),
+            std::vector<std::size_t>(6 * dice_count + 1),
+            [](std::vector<std::size_t> lhs, std::vector<std::size_t> const& rhs) {
+                std::ranges::transform(lhs, rhs, lhs.begin(), std::plus<>{});
+                return lhs;
+            },
+            [](auto const& chunk) {
+                std::vector<std::size_t> distribution(6 * dice_count + 1);
+                count_sums(chunk, distribution);
+                return distribution;
+            }
+        )
+    ;
+}
+
+template <std::size_t dice_count>
+auto prob_dist_sum_dice_work_stealing() {
+    auto tuples = dice_tuples<dice_count>();
+
+    return
+        cartesian_parallel_for_each(
+            tuples,
+            [](std::vector<std::size_t>& distribution, auto const& tuple) {
+                count_sum(tuple, distribution);
+            },
+            [](std::vector<std::size_t> lhs, std::vector<std::size_t> const& rhs) {
+                std::ranges::transform(lhs, rhs, lhs.begin(), std::plus<>{});
+                return lhs;
+            },
+            std::vector<std::size_t>(6 * dice_count + 1)
+        )
+    ;
+}
+
+int main(int const, char const* const []) {
+    constexpr std::size_t dice_count = 7;
+
+    auto const serial = prob_dist_sum_dice_serial<dice_count>();
+    auto const parallel = prob_dist_sum_dice_parallel<dice_count>();
+    auto const work_stealing = prob_dist_sum_dice_work_stealing<dice_count>();
+
+    auto const denominator = std::reduce(parallel.begin(), parallel.end());
+    for (std::size_t sum = dice_count; sum != parallel.size(); ++sum) {
+        std::cout << sum << ": " << parallel[sum] << '/' << denominator << '\n';
+    }
+
+    if (serial != parallel) {
+        std::cerr << "The parallel and the serial distributions differ!\n";
+        return 1;
+    }
+
+    if (serial != work_stealing) {
+        std::cerr << "The work-stealing and the serial distributions differ!\n";
+        return 1;
+    }
+
+    return 0;
+}
@@ -1,9 +1,19 @@
+#include <array>
 #include <forward_list>
+#include <limits>
 #include <list>
+#include <map>
+#include <numeric>
+#include <span>
+#include <sstream>
+#include <stdexcept>
+#include <string>
 #include <vector>
 
 #include "gtest/gtest.h"
 
+#include "../cached_cartesian_product_view.h"
+#include "../cartesian_batch_generator.h"
 #include "../cartesian_product_view.h"
 
 struct {
@@ -47,41 +57,56 @@ TEST(concept_checks, bidirectional_range) {
     {
         auto cpv = cartesian_product();
         static_assert(std::ranges::bidirectional_range<decltype(cpv)>);
+        static_assert(std::ranges::random_access_range<decltype(cpv)>);
+    }
+    {
+        auto cpv = cartesian_product(list);
+        static_assert(std::ranges::bidirectional_range<decltype(cpv)>);
         static_assert(!std::ranges::random_access_range<decltype(cpv)>);
     }
     {
-        auto cpv = cartesian_product(vector);
+        auto cpv = cartesian_product(vector, list);
         static_assert(std::ranges::bidirectional_range<decltype(cpv)>);
         static_assert(!std::ranges::random_access_range<decltype(cpv)>);
     }
+    {
+        auto cpv = cartesian_product(vector);
+        static_assert(std::ranges::bidirectional_range<decltype(cpv)>);
+        static_assert(std::ranges::random_access_range<decltype(cpv)>);
+    }
     {
         static_assert(std::ranges::contiguous_range<decltype(empty)>);
         auto cpv = cartesian_product(empty);
         static_assert(std::ranges::bidirectional_range<decltype(cpv)>);
-        static_assert(!std::ranges::random_access_range<decltype(cpv)>);
+        static_assert(std::ranges::random_access_range<decltype(cpv)>);
     }
 }
 
-// a cartesian_product_view<> is never a borrowed_range
+// a cartesian_product_view<> is a borrowed_range,
+// if all of the constituent ranges are borrowed_ranges
 TEST(concept_checks, borrowed_range) {
     {
         auto cpv = cartesian_product();
-        static_assert(!std::ranges::borrowed_range<decltype(cpv)>);
+        static_assert(std::ranges::borrowed_range<decltype(cpv)>);
     }
     {
         auto cpv = cartesian_product(forward_list);
-        static_assert(!std::ranges::borrowed_range<decltype(cpv)>);
+        static_assert(std::ranges::borrowed_range<decltype(cpv)>);
     }
     {
-        auto cpv = cartesian_product(list);
-        static_assert(!std::ranges::borrowed_range<decltype(cpv)>);
+        auto cpv = cartesian_product(list, vector);
+        static_assert(std::ranges::borrowed_range<decltype(cpv)>);
     }
     {
-        auto cpv = cartesian_product(vector);
+        auto cpv = cartesian_product(empty, std::views::iota(0, 3));
+        static_assert(std::ranges::borrowed_range<decltype(cpv)>);
+    }
+    {
+        auto cpv = cartesian_product(vector, std::vector{ 0, 1, 2 });
         static_assert(!std::ranges::borrowed_range<decltype(cpv)>);
     }
     {
-        auto cpv = cartesian_product(empty);
+        auto cpv = cartesian_product(vector | std::views::filter([](int) { return true; }));
         static_assert(!std::ranges::borrowed_range<decltype(cpv)>);
     }
 }
@@ -198,11 +223,12 @@ TEST(concept_checks, output_range) {
     }
 }
 
-// a cartesian_product_view<> is never a random_access_range (at least currently)
+// a cartesian_product_view<> is a random_access_range,
+// if all of the constituent ranges are sized random_access_ranges
 TEST(concept_checks, random_access_range) {
     {
         auto cpv = cartesian_product();
-        static_assert(!std::ranges::random_access_range<decltype(cpv)>);
+        static_assert(std::ranges::random_access_range<decltype(cpv)>);
     }
     {
         auto cpv = cartesian_product(forward_list);
@@ -214,10 +240,18 @@ TEST(concept_checks, random_access_range) {
     }
     {
         auto cpv = cartesian_product(vector);
-        static_assert(!std::ranges::random_access_range<decltype(cpv)>);
+        static_assert(std::ranges::random_access_range<decltype(cpv)>);
     }
     {
         auto cpv = cartesian_product(empty);
+        static_assert(std::ranges::random_access_range<decltype(cpv)>);
+    }
+    {
+        auto cpv = cartesian_product(vector, vector);
+        static_assert(std::ranges::random_access_range<decltype(cpv)>);
+    }
+    {
+        auto cpv = cartesian_product(vector, list);
         static_assert(!std::ranges::random_access_range<decltype(cpv)>);
     }
 }
@@ -319,6 +353,27 @@ TEST(concept_checks, viewable_range) {
     }
 }
 
+// the legacy iterator category of a cartesian_product_view<> is always input,
+// since its reference type is a prvalue std::tuple<>
+TEST(concept_checks, iterator_category) {
+    {
+        auto cpv = cartesian_product();
+        static_assert(std::same_as<std::iterator_traits<std::ranges::iterator_t<decltype(cpv)>>::iterator_category, std::input_iterator_tag>);
+    }
+    {
+        auto cpv = cartesian_product(forward_list);
+        static_assert(std::same_as<std::iterator_traits<std::ranges::iterator_t<decltype(cpv)>>::iterator_category, std::input_iterator_tag>);
+    }
+    {
+        auto cpv = cartesian_product(vector);
+        static_assert(std::same_as<std::iterator_traits<std::ranges::iterator_t<decltype(cpv)>>::iterator_category, std::input_iterator_tag>);
+    }
+    {
+        auto cpv = cartesian_product(vector);
+        static_assert(std::same_as<std::iterator_traits<std::ranges::iterator_t<decltype(cpv.chunks(1))>>::iterator_category, std::random_access_iterator_tag>);
+    }
+}
+
 template <typename T>
 struct range_associated_types : ::testing::Test {
     static constexpr bool deep_const = std::tuple_element_t<0, T>::value;
@@ -465,4 +520,1160 @@ TEST(general, not_common_range) {
             std::tuple{ 0, 0 }
         }
     );
-}
\ No newline at end of file
+}
+
+TEST(general, not_common_range_end_cache) {
+    auto calls = 0;
+    auto twv =
+        list // [0, 1, 2, 3]
+      | std::views::take_while(
+            [&calls](int const i) {
+                ++calls;
+                return i < 3;
+            }
+        )
+    ;
+
+    {
+        auto cpv = cartesian_product(vector, twv, twv);
+        check_equal(cpv | std::views::reverse, std::vector(cpv.begin(), cpv.end()) | std::views::reverse);
+    }
+    {
+        // the end of twv is materialized once, then it's reused by every iterator
+        auto cpv = cartesian_product(twv, vector);
+        calls = 0;
+        static_cast<void>(std::ranges::end(cpv));
+        EXPECT_EQ(calls, 4);
+        static_cast<void>(std::ranges::end(cpv));
+        static_cast<void>(std::ranges::end(std::as_const(cpv)));
+        EXPECT_EQ(calls, 8);
+        static_cast<void>(std::ranges::end(std::as_const(cpv)));
+        EXPECT_EQ(calls, 8);
+
+        // the cache isn't propagated, as it refers to the views of the source
+        auto copy = cpv;
+        static_cast<void>(std::ranges::end(copy));
+        EXPECT_EQ(calls, 12);
+        check_equal(copy | std::views::reverse, std::vector(cpv.begin(), cpv.end()) | std::views::reverse);
+    }
+    {
+        // a borrowed product keeps the end iterators in its iterators, so a reverse traversal wraps around
+        // the views without walking them again, just like an owning one (which compares against the sentinels, too)
+        auto owning = cartesian_product(vector, twv);
+        auto borrowed = cartesian_product(vector, std::ranges::ref_view{ twv });
+        static_assert(std::ranges::borrowed_range<decltype(borrowed)> && !std::ranges::borrowed_range<decltype(owning)>);
+
+        auto const walk =
+            [&](auto& cpv) {
+                calls = 0;
+                auto it = std::ranges::end(cpv);
+                for (auto const begin = std::ranges::begin(cpv); it != begin; --it) {}
+                return calls;
+            }
+        ;
+        auto const owning_calls = walk(owning);
+        EXPECT_LE(walk(borrowed), owning_calls);
+        check_equal(borrowed | std::views::reverse, owning | std::views::reverse);
+    }
+}
+
+TEST(general, begin_cache) {
+    // a view that counts the calls to its begin()
+    struct counting_view : std::ranges::view_interface<counting_view> {
+        auto begin() const {
+            ++*calls;
+            return elements->begin();
+        }
+
+        auto end() const {
+            return elements->end();
+        }
+
+        // rather than the size computed from begin() by std::ranges::view_interface<>
+        auto size() const {
+            return elements->size();
+        }
+
+        std::vector<int>* elements{};
+        int* calls{};
+    };
+
+    auto calls = 0;
+    counting_view const view{ {}, &vector, &calls };
+    auto cpv = cartesian_product(view, view, view);
+    static_assert(std::ranges::random_access_range<decltype(cpv)> && !std::ranges::borrowed_range<decltype(cpv)>);
+
+    // the beginnings of the views are kept by the iterators, so carrying over doesn't ask for them again
+    auto const begin = cpv.begin();
+    auto const begin_calls = calls;
+    auto it = begin;
+    for (; it != std::default_sentinel; ++it) {}
+    for (; it != begin; --it) {}
+    it += 13;
+    it -= 5;
+    EXPECT_EQ(it - begin, 8);
+    EXPECT_EQ(calls, begin_calls);
+}
+
+TEST(general, not_const_iterable) {
+    auto fv =
+        vector
+      | std::views::filter(
+            [](int const i) {
+                return i != 1;
+            }
+        )
+    ;
+
+    auto cpv = cartesian_product(vector, fv);
+    static_assert(std::ranges::bidirectional_range<decltype(cpv)>);
+    static_assert(!std::ranges::range<decltype(cpv) const>);
+    check_equal(
+        cpv | std::views::reverse,
+        {
+            std::tuple{ 2, 2 },
+            std::tuple{ 2, 0 },
+            std::tuple{ 1, 2 },
+            std::tuple{ 1, 0 },
+            std::tuple{ 0, 2 },
+            std::tuple{ 0, 0 }
+        }
+    );
+}
+
+TEST(general, carry) {
+    auto cpv = cartesian_product(list, vector, list, vector);
+    std::vector<std::tuple<int, int, int, int>> expected{};
+    for (auto const i : list) {
+        for (auto const j : vector) {
+            for (auto const k : list) {
+                for (auto const l : vector) {
+                    expected.emplace_back(i, j, k, l);
+                }
+            }
+        }
+    }
+
+    check_equal(cpv, expected);
+    check_equal(cpv | std::views::reverse, expected | std::views::reverse);
+
+    auto it = std::ranges::begin(cpv);
+    std::ranges::advance(it, 17);
+    auto jt = std::ranges::prev(std::ranges::next(it, 23), 23);
+    EXPECT_EQ(it, jt);
+    EXPECT_EQ(*jt, expected[17]);
+}
+
+TEST(general, random_access) {
+    int ints[]{ 0, 1, 2, 3 };
+    auto cpv = cartesian_product(vector, ints, vector);
+    auto const size = std::ranges::ssize(cpv);
+    EXPECT_EQ(size, 36);
+
+    auto const begin = std::ranges::begin(cpv);
+    auto const end = std::ranges::end(cpv);
+    EXPECT_EQ(end - begin, size);
+    EXPECT_EQ(begin - end, -size);
+    EXPECT_EQ(begin + size, end);
+    EXPECT_EQ(end - size, begin);
+    EXPECT_EQ(std::ranges::distance(cpv), size);
+
+    auto it = begin;
+    for (std::ptrdiff_t n = 0; n != size; ++n, ++it) {
+        EXPECT_EQ(it - begin, n);
+        EXPECT_EQ(end - it, size - n);
+        EXPECT_EQ(begin + n, it);
+        EXPECT_EQ(end - (size - n), it);
+        EXPECT_EQ(begin[n], *it);
+        EXPECT_EQ(*it, std::tuple(n / 12, n / 3 % 4, n % 3));
+        EXPECT_TRUE(begin <= it && it < end);
+        EXPECT_TRUE(std::ranges::next(begin, n) == it);
+    }
+    EXPECT_EQ(it, end);
+
+    for (std::ptrdiff_t from = 0; from <= size; ++from) {
+        for (std::ptrdiff_t to = 0; to <= size; ++to) {
+            auto jt = begin + from;
+            jt += to - from;
+            EXPECT_EQ(jt - begin, to);
+            EXPECT_EQ((jt <=> begin + from), (to <=> from));
+        }
+    }
+
+    check_equal(
+        cartesian_product(vector, vector) | std::views::drop(4) | std::views::take(3),
+        {
+            std::tuple{ 1, 1 },
+            std::tuple{ 1, 2 },
+            std::tuple{ 2, 0 }
+        }
+    );
+
+    {
+        auto cpv = cartesian_product(vector, empty);
+        EXPECT_EQ(std::ranges::end(cpv) - std::ranges::begin(cpv), 0);
+        EXPECT_EQ(std::ranges::begin(cpv) + 0, std::ranges::end(cpv));
+    }
+}
+
+TEST(general, chunks) {
+    auto const concatenate =
+        [](auto const& chunks) {
+            std::vector<std::ranges::range_value_t<std::ranges::range_value_t<decltype(chunks)>>> tuples{};
+            for (auto const& chunk : chunks) {
+                tuples.insert(tuples.end(), chunk.begin(), chunk.end());
+            }
+            return tuples;
+        }
+    ;
+
+    {
+        auto cpv = cartesian_product(vector, vector, vector);
+        auto const expected = std::vector(cpv.begin(), cpv.end());
+        for (std::size_t n = 1; n != 32; ++n) {
+            auto const chunks = cpv.chunks(n);
+            EXPECT_EQ(chunks.size(), n);
+            check_equal(concatenate(chunks), expected);
+            for (auto const& chunk : chunks) {
+                auto const size = std::ranges::ssize(chunk);
+                EXPECT_TRUE(size == 27 / std::ptrdiff_t(n) || size == 27 / std::ptrdiff_t(n) + 1);
+            }
+        }
+    }
+    {
+        auto cpv = cartesian_product(forward_list, list);
+        auto const expected = std::vector(cpv.begin(), cpv.end());
+        for (std::size_t n = 1; n != 8; ++n) {
+            auto const chunks = cpv.chunks(n);
+            EXPECT_EQ(chunks.size(), n);
+            check_equal(concatenate(chunks), expected);
+            for (auto const& chunk : chunks) {
+                auto const size = std::ranges::distance(chunk);
+                EXPECT_TRUE(size == 3 / std::ptrdiff_t(n) * 4 || size == (3 / std::ptrdiff_t(n) + 1) * 4);
+            }
+        }
+    }
+    {
+        auto cpv = cartesian_product(list, empty);
+        for (auto const& chunk : cpv.chunks(3)) {
+            EXPECT_TRUE(chunk.empty());
+        }
+    }
+    {
+        // a filter_view can't be iterated through a const reference, so neither can the chunks of a const product
+        auto cpv = cartesian_product(list | std::views::filter([](int) { return true; }));
+        auto const chunkable = [](auto& cpv) {
+            return requires { cpv.chunks(std::size_t{}); };
+        };
+        static_assert(chunkable(cpv));
+        static_assert(!chunkable(std::as_const(cpv)));
+    }
+    {
+        // the chunks of a temporary product would dangle, unless its iterators don't refer to it
+        auto borrowed = cartesian_product(vector, list);
+        auto owning = cartesian_product(vector, std::vector{ 0, 1 });
+        auto const chunkable = [](auto&& cpv) {
+            return requires { std::move(cpv).chunks(std::size_t{}); };
+        };
+        static_assert(chunkable(borrowed));
+        static_assert(!chunkable(owning));
+        check_equal(concatenate(cartesian_product(vector, list).chunks(5)), borrowed);
+    }
+}
+
+TEST(general, partition) {
+    auto cpv = cartesian_product(vector, vector);
+    check_equal(
+        cpv.partition(2, 5),
+        {
+            std::tuple{ 0, 2 },
+            std::tuple{ 1, 0 },
+            std::tuple{ 1, 1 }
+        }
+    );
+    EXPECT_TRUE(cpv.partition(9, 9).empty());
+    EXPECT_EQ(cpv.partition(0, 9).begin(), cpv.begin());
+    EXPECT_EQ(cpv.partition(0, 9).end(), cpv.end());
+}
+
+TEST(general, parallel_for_each) {
+    std::vector<int> ints(64);
+    std::iota(ints.begin(), ints.end(), 0);
+
+    auto const sum =
+        [](auto const& tuple) {
+            return std::apply(
+                [](auto const... elements) {
+                    return (0LL + ... + elements);
+                },
+                tuple
+            );
+        }
+    ;
+    auto const plus =
+        [](long long const lhs, long long const rhs) {
+            return lhs + rhs;
+        }
+    ;
+
+    {
+        // the cost of a tuple varies by two orders of magnitude
+        auto const weighted_sum =
+            [&](auto const& tuple) {
+                auto const weight = std::get<0>(tuple) < 4 ? 100 : 1;
+                auto result = 0LL;
+                for (auto i = 0; i != weight; ++i) {
+                    result += sum(tuple);
+                }
+                return result;
+            }
+        ;
+
+        auto cpv = cartesian_product(ints, ints, ints);
+        auto const expected = std::transform_reduce(cpv.begin(), cpv.end(), 0LL, std::plus<>{}, weighted_sum);
+        for (std::size_t thread_count : { 1, 2, 3, 8 }) {
+            auto const actual =
+                cartesian_parallel_for_each(
+                    cpv,
+                    [&](long long& accumulator, auto const& tuple) {
+                        accumulator += weighted_sum(tuple);
+                    },
+                    plus,
+                    0LL,
+                    thread_count
+                )
+            ;
+            EXPECT_EQ(actual, expected);
+        }
+    }
+    {
+        auto cpv = cartesian_product(list, forward_list, list);
+        auto const expected = std::transform_reduce(cpv.begin(), cpv.end(), 0LL, std::plus<>{}, sum);
+        auto const actual =
+            cartesian_parallel_for_each(
+                cpv,
+                [&](long long& accumulator, auto const& tuple) {
+                    accumulator += sum(tuple);
+                },
+                plus,
+                0LL,
+                4
+            )
+        ;
+        EXPECT_EQ(actual, expected);
+    }
+    {
+        // without an identity, the results of f are folded into value-initialized accumulators
+        auto cpv = cartesian_product(ints, list, ints);
+        auto const expected = std::transform_reduce(cpv.begin(), cpv.end(), 0LL, std::plus<>{}, sum);
+        auto const actual = cartesian_parallel_for_each(cpv, sum, plus);
+        static_assert(std::same_as<decltype(actual), long long const>);
+        EXPECT_EQ(actual, expected);
+    }
+    {
+        auto cpv = cartesian_product(ints, empty);
+        auto const actual = cartesian_parallel_for_each(cpv, [](long long&, auto const&) {}, plus, 42LL, 4);
+        EXPECT_EQ(actual, 4 * 42);
+    }
+    {
+        auto cpv = cartesian_product(ints, ints);
+        EXPECT_THROW(
+            cartesian_parallel_for_each(
+                cpv,
+                [](long long&, auto const& tuple) {
+                    if (std::get<0>(tuple) == 42) {
+                        throw std::runtime_error{ "42" };
+                    }
+                },
+                plus,
+                0LL,
+                4
+            ),
+            std::runtime_error
+        );
+    }
+}
+
+TEST(general, for_each) {
+    {
+        auto cpv = cartesian_product(list, vector, forward_list);
+        std::vector<std::tuple<int, int, char>> tuples{};
+        cpv.for_each(
+            [&](std::tuple<int&, int&, char&> const tuple) {
+                tuples.push_back(tuple);
+            }
+        );
+        check_equal(tuples, cpv);
+    }
+    {
+        auto const cpv = cartesian_product(vector, vector);
+        auto count = 0;
+        cpv.for_each(
+            [&](std::tuple<int const&, int const&>) {
+                ++count;
+            }
+        );
+        EXPECT_EQ(count, 9);
+    }
+    {
+        // prvalue elements of the outer views are copied into every tuple rather than moved
+        auto strings =
+            vector
+          | std::views::transform(
+                [](int const i) {
+                    return std::string(32, static_cast<char>('0' + i));
+                }
+            )
+        ;
+
+        std::vector<std::tuple<std::string, std::string>> tuples{};
+        cartesian_product(strings, strings).for_each(
+            [&](std::tuple<std::string, std::string> tuple) {
+                tuples.push_back(std::move(tuple));
+            }
+        );
+        EXPECT_EQ(tuples.size(), 9);
+        for (std::size_t i = 0; i != tuples.size(); ++i) {
+            EXPECT_EQ(std::get<0>(tuples[i]), std::string(32, static_cast<char>('0' + i / 3)));
+            EXPECT_EQ(std::get<1>(tuples[i]), std::string(32, static_cast<char>('0' + i % 3)));
+        }
+    }
+    {
+        auto calls = 0;
+        cartesian_product().for_each([&](std::tuple<>) { ++calls; });
+        cartesian_product(vector, empty).for_each([&](auto const&) { ++calls; });
+        EXPECT_EQ(calls, 0);
+    }
+}
+
+TEST(general, blocks) {
+    {
+        auto cpv = cartesian_product(list, forward_list, vector);
+        auto blocks = cpv.blocks();
+        static_assert(std::same_as<std::ranges::range_reference_t<decltype(blocks)>, std::tuple<int&, char&, std::span<int>>>);
+
+        std::vector<std::tuple<int, char, int>> tuples{};
+        for (auto const& [i, c, block] : blocks) {
+            EXPECT_EQ(block.data(), vector.data());
+            for (auto const j : block) {
+                tuples.emplace_back(i, c, j);
+            }
+        }
+        check_equal(tuples, cpv);
+    }
+    {
+        auto const cpv = cartesian_product(vector, vector);
+        auto blocks = cpv.blocks();
+        static_assert(std::same_as<std::ranges::range_reference_t<decltype(blocks)>, std::tuple<int const&, std::span<int const>>>);
+        EXPECT_EQ(std::ranges::distance(blocks), 3);
+    }
+    {
+        auto cpv = cartesian_product(vector, list);
+        std::vector<std::tuple<int, int>> tuples{};
+        for (auto const& [i, block] : cpv.blocks()) {
+            static_assert(std::same_as<std::ranges::range_reference_t<decltype(block)>, int&>);
+            for (auto const j : block) {
+                tuples.emplace_back(i, j);
+            }
+        }
+        check_equal(tuples, cpv);
+    }
+    {
+        auto const cpv = cartesian_product(list);
+        auto blocks = cpv.blocks();
+        EXPECT_EQ(std::ranges::distance(blocks), 1);
+        auto const& [block] = *std::ranges::begin(blocks);
+        static_assert(std::same_as<std::ranges::range_reference_t<decltype(block)>, int const&>);
+        check_equal(block, list);
+    }
+    {
+        // the blocks refer to the views of the product, so they can't be taken from a temporary one
+        auto cpv = cartesian_product(vector, vector);
+        auto const blockable = [](auto&& cpv) {
+            return requires { std::forward<decltype(cpv)>(cpv).blocks(); };
+        };
+        static_assert(blockable(cpv) && blockable(std::as_const(cpv)));
+        static_assert(!blockable(std::move(cpv)));
+    }
+}
+
+constexpr std::array<int, 3> digits{ 1, 2, 3 };
+constexpr std::array<char, 2> letters{ 'a', 'b' };
+
+TEST(general, constant_evaluation) {
+    static_assert(
+        [] {
+            auto const cpv = cartesian_product(digits, letters);
+            int i = 0;
+            for (auto const [d, l] : cpv) {
+                if (d != digits[i / 2] || l != letters[i % 2]) {
+                    return false;
+                }
+                ++i;
+            }
+            return i == 6 && cpv.size() == 6;
+        }()
+    );
+    static_assert(
+        [] {
+            auto const cpv = cartesian_product(digits, letters);
+            auto it = std::ranges::end(cpv);
+            --it;
+            it -= 3;
+            return *it == std::tuple{ 2, 'a' } && it[-1] == std::tuple{ 1, 'b' } && it - std::ranges::begin(cpv) == 2;
+        }()
+    );
+    static_assert(
+        [] {
+            // the distribution of the sum of 3 dice
+            std::array<int, 19> counts{};
+            auto const die = std::views::iota(1, 7);
+            cartesian_product(die, die, die).for_each(
+                [&](auto const& tuple) {
+                    ++counts[std::apply([](auto... dice) { return (... + dice); }, tuple)];
+                }
+            );
+            return counts[3] == 1 && counts[10] == 27 && counts[18] == 1;
+        }()
+    );
+}
+
+TEST(general, static_extent) {
+    std::array<int, 3> array{ 1, 2, 3 };
+    int c_array[2]{ 4, 5 };
+    std::span<int, 2> const span{ c_array };
+    auto cpv = cartesian_product(array, c_array, span, std::array<int, 2>{ 6, 7 });
+    static_assert(decltype(cpv)::size() == 24);
+    static_assert(std::ranges::size(std::as_const(cpv)) == 24);
+
+    // the same product with dynamic radices
+    std::vector<int> vector0{ 1, 2, 3 };
+    std::vector<int> vector1{ 4, 5 };
+    std::vector<int> vector2{ 6, 7 };
+    auto expected = cartesian_product(vector0, vector1, vector1, vector2);
+    EXPECT_EQ(expected.size(), cpv.size());
+    static_assert(std::same_as<decltype(cpv.size()), decltype(expected.size())>);
+
+    check_equal(cpv, expected);
+    auto const begin = std::ranges::begin(cpv);
+    auto const expected_begin = std::ranges::begin(expected);
+    for (std::ptrdiff_t n = 0; n != 24; ++n) {
+        auto const it = begin + n;
+        EXPECT_EQ(*it, *(expected_begin + n));
+        EXPECT_EQ(it - begin, n);
+        EXPECT_EQ(std::ranges::end(cpv) - it, 24 - n);
+    }
+
+    EXPECT_EQ(cartesian_product(array, vector0).size(), 9);
+}
+
+TEST(general, rank_unrank) {
+    auto cpv = cartesian_product(vector, std::views::iota(0, 4), std::array{ 'a', 'b' });
+    using difference_type = std::ranges::range_difference_t<decltype(cpv)>;
+    auto const size = static_cast<difference_type>(cpv.size());
+
+    std::vector<difference_type> indices(static_cast<std::size_t>(size));
+    std::iota(indices.begin(), indices.end(), 0);
+    std::vector<std::array<difference_type, 3>> positions(indices.size());
+    cpv.unrank(indices, positions);
+
+    difference_type n = 0;
+    for (auto it = cpv.begin(); it != cpv.end(); ++it, ++n) {
+        EXPECT_EQ(cpv.index_of(it), n);
+        EXPECT_EQ(cpv.at(n), *it);
+        EXPECT_EQ(std::as_const(cpv).at(n), *it);
+
+        auto const& [i, j, k] = positions[static_cast<std::size_t>(n)];
+        EXPECT_EQ(*it, std::tuple(vector[static_cast<std::size_t>(i)], static_cast<int>(j), "ab"[k]));
+    }
+    EXPECT_EQ(cpv.index_of(cpv.end()), size);
+    EXPECT_EQ(std::as_const(cpv).index_of(std::as_const(cpv).begin() + 5), 5);
+
+    EXPECT_THROW(cpv.at(-1), std::out_of_range);
+    EXPECT_THROW(cpv.at(size), std::out_of_range);
+}
+
+TEST(general, checkpoint_restore) {
+    // the remaining tuples of a traversal resumed from a serialized checkpoint are the same as the ones of the original
+    auto const resume =
+        [](auto& cpv, std::ptrdiff_t const done) {
+            std::stringstream file{};
+            {
+                auto it = std::ranges::next(cpv.begin(), done);
+                for (auto const position : cpv.checkpoint(it)) {
+                    file << position << ' ';
+                }
+            }
+
+            std::array<std::ranges::range_difference_t<decltype(cpv)>, std::tuple_size_v<std::ranges::range_value_t<decltype(cpv)>>> positions{};
+            for (auto& position : positions) {
+                file >> position;
+            }
+
+            auto it = cpv.restore(positions);
+            EXPECT_EQ(it, std::ranges::next(cpv.begin(), done));
+            check_equal(std::ranges::subrange(it, cpv.end()), std::ranges::subrange(std::ranges::next(cpv.begin(), done), cpv.end()));
+            return positions;
+        }
+    ;
+
+    {
+        auto cpv = cartesian_product(list, forward_list, vector);
+        EXPECT_EQ(resume(cpv, 0), (std::array<std::ptrdiff_t, 3>{ 0, 0, 0 }));
+        EXPECT_EQ(resume(cpv, 17), (std::array<std::ptrdiff_t, 3>{ 1, 2, 2 }));
+        EXPECT_EQ(resume(cpv, 36), (std::array<std::ptrdiff_t, 3>{ 4, 0, 0 }));
+    }
+    {
+        auto cpv = cartesian_product(vector, std::views::iota(0, 5));
+        EXPECT_EQ(resume(cpv, 7), (std::array<std::ptrdiff_t, 2>{ 1, 2 }));
+
+        // the flat index of index_of() is a checkpoint as well
+        auto const it = cpv.begin() + 11;
+        EXPECT_EQ(cpv.restore(cpv.index_of(it)), it);
+        EXPECT_EQ(cpv.restore(15), cpv.end());
+        EXPECT_EQ(std::as_const(cpv).restore({ 1, 2 }), std::as_const(cpv).begin() + 7);
+    }
+    {
+        // the end of an empty product is at the end of its outermost view, too
+        auto cpv = cartesian_product(list, empty);
+        EXPECT_EQ(resume(cpv, 0), (std::array<std::ptrdiff_t, 2>{ 4, 0 }));
+    }
+}
+
+TEST(general, checked_size) {
+    // 454279 * 31252369 * 649657 == 2^63 - 1
+    auto const iota0 = std::views::iota(0, 454279);
+    auto const iota1 = std::views::iota(0, 31252369);
+    auto const iota2 = std::views::iota(0, 649657);
+    auto const iota3 = std::views::iota(0, 2);
+
+    auto const largest = cartesian_product(iota0, iota1, iota2);
+    auto const max = static_cast<std::uint64_t>(std::numeric_limits<std::int64_t>::max());
+    ASSERT_TRUE(largest.checked_size());
+    EXPECT_EQ(*largest.checked_size(), max);
+    EXPECT_EQ(largest.size(), max);
+    EXPECT_EQ(std::ranges::end(largest) - std::ranges::begin(largest), std::numeric_limits<std::int64_t>::max());
+    EXPECT_EQ(*(std::ranges::end(largest) - 1), std::tuple(454278, 31252368, 649656));
+
+    EXPECT_FALSE(cartesian_product(iota0, iota1, iota2, iota3).checked_size());
+    EXPECT_FALSE(cartesian_product(iota3, iota1, iota1, iota1).checked_size());
+
+    EXPECT_EQ(cartesian_product(iota1, iota1, iota1, std::views::iota(0, 0)).checked_size(), 0U);
+    EXPECT_EQ(cartesian_product(vector, list).checked_size(), 12U);
+}
+
+TEST(general, wide_view_difference) {
+    // the difference type of a 64-bit iota is wider than 64 bits (e.g. a class type, or an __int128 that isn't an integral
+    // type in strict mode), so the size of the product can't be the unsigned counterpart of its difference type
+    auto const cpv = cartesian_product(std::views::iota(0LL, 3LL), std::views::iota(std::size_t{ 0 }, std::size_t{ 2 }));
+    static_assert(std::ranges::random_access_range<decltype(cpv)> && std::ranges::sized_range<decltype(cpv)>);
+    EXPECT_EQ(cpv.size(), 6U);
+    EXPECT_EQ(cpv.checked_size(), 6U);
+    EXPECT_EQ(std::ranges::distance(cpv), 6);
+    EXPECT_EQ(cpv.at(3), std::tuple(1LL, std::size_t{ 1 }));
+    EXPECT_EQ(cpv.index_of(cpv.begin() + 5), 5);
+    check_equal(
+        cpv,
+        std::initializer_list<std::tuple<long long, std::size_t>>{
+            { 0, 0 }, { 0, 1 }, { 1, 0 }, { 1, 1 }, { 2, 0 }, { 2, 1 }
+        }
+    );
+}
+
+TEST(general, borrowed_range) {
+    auto const it = std::ranges::find(cartesian_product(list, vector), std::tuple(2, 1));
+    static_assert(!std::same_as<decltype(it), std::ranges::dangling const>);
+    EXPECT_EQ(*it, std::tuple(2, 1));
+
+    // the iterators outlive the product
+    auto [first, last] =
+        [] {
+            auto cpv = cartesian_product(vector, std::views::iota(0, 2));
+            return std::pair(cpv.begin() + 1, cpv.end());
+        }()
+    ;
+    --last;
+    EXPECT_EQ(*last, std::tuple(2, 1));
+    EXPECT_EQ(last - first, 4);
+    check_equal(std::ranges::subrange(first, last), { std::tuple(0, 1), std::tuple(1, 0), std::tuple(1, 1), std::tuple(2, 0) });
+
+    // the beginnings are kept by every iterator, so the ones of a borrowed product only drop the pointer to the product
+    auto borrowed = cartesian_product(vector, vector, vector);
+    auto owning = cartesian_product(vector, vector, std::vector{ 0, 1, 2 });
+    static_assert(std::ranges::borrowed_range<decltype(borrowed)> && !std::ranges::borrowed_range<decltype(owning)>);
+    static_assert(sizeof(borrowed.begin()) + sizeof(void*) == sizeof(owning.begin()));
+}
+
+TEST(general, compact) {
+    std::array<int, 3> array{ 0, 1, 2 };
+    auto cpv = cartesian_product(vector, array, std::views::iota(0, 300));
+    auto compact = cpv.compact<std::uint16_t>();
+    static_assert(std::ranges::random_access_range<decltype(compact)> && std::ranges::sized_range<decltype(compact)>);
+    static_assert(std::same_as<std::ranges::range_reference_t<decltype(compact)>, std::ranges::range_reference_t<decltype(cpv)>>);
+    static_assert(std::same_as<decltype(compact.begin())::indices, std::tuple<std::uint16_t, std::uint8_t, std::uint16_t>>);
+    static_assert(sizeof(compact.begin()) < sizeof(cpv.begin()));
+
+    EXPECT_EQ(compact.size(), cpv.size());
+    check_equal(compact, cpv);
+    check_equal(compact | std::views::reverse, cpv | std::views::reverse);
+
+    auto const begin = cpv.begin();
+    auto const compact_begin = compact.begin();
+    for (std::ptrdiff_t n : { 0, 1, 299, 300, 899, 900, 1500, 2699 }) {
+        EXPECT_EQ(compact_begin[n], begin[n]);
+        EXPECT_EQ(compact.end() - (compact_begin + n), 2700 - n);
+        EXPECT_LT(compact_begin + n, compact.end());
+    }
+
+    auto const const_compact = std::as_const(cpv).compact();
+    static_assert(std::same_as<std::ranges::range_reference_t<decltype(const_compact)>, std::tuple<int const&, int const&, int>>);
+    EXPECT_EQ(const_compact.size(), cpv.size());
+    EXPECT_EQ(const_compact.begin()[1234], begin[1234]);
+
+    auto empty_product = cartesian_product(vector, std::views::iota(0, 0), vector);
+    EXPECT_TRUE(empty_product.compact().empty());
+
+    // the iterators point to the product, even if it's a borrowed_range, so they can't be taken from a temporary one
+    auto const compactable = [](auto&& cpv) {
+        return requires { std::forward<decltype(cpv)>(cpv).compact(); };
+    };
+    static_assert(std::ranges::borrowed_range<decltype(empty_product)>);
+    static_assert(compactable(empty_product) && compactable(std::as_const(empty_product)));
+    static_assert(!compactable(std::move(empty_product)));
+}
+
+TEST(general, default_sentinel) {
+    {
+        auto cpv = cartesian_product(list, forward_list, vector);
+        static_assert(std::sentinel_for<std::default_sentinel_t, std::ranges::iterator_t<decltype(cpv)>>);
+        static_assert(std::ranges::common_range<decltype(cpv)>);
+
+        check_equal(std::ranges::subrange(cpv.begin(), std::default_sentinel), cpv);
+        EXPECT_TRUE(cpv.end() == std::default_sentinel);
+        EXPECT_FALSE(std::ranges::next(cpv.begin(), 35) == std::default_sentinel);
+        EXPECT_TRUE(std::ranges::next(cpv.begin(), 36) == std::default_sentinel);
+    }
+    {
+        auto cpv = cartesian_product(vector, empty);
+        EXPECT_TRUE(cpv.begin() == std::default_sentinel);
+        EXPECT_TRUE(cartesian_product().begin() == std::default_sentinel);
+    }
+    {
+        auto cpv = cartesian_product(vector, vector);
+        auto compact = cpv.compact();
+        std::size_t count = 0;
+        for (auto it = compact.begin(); it != std::default_sentinel; ++it) {
+            ++count;
+        }
+        EXPECT_EQ(count, 9U);
+    }
+}
+
+TEST(general, skip_suffix) {
+    auto cpv = cartesian_product(list, forward_list, vector);
+    auto it = cpv.begin();
+    EXPECT_EQ(it.skip_suffix(1), 1U);
+    EXPECT_EQ(*it, std::tuple(0, '1', 0));
+    ++it;
+    EXPECT_EQ(it.skip_suffix(2), 2U);
+    EXPECT_EQ(*it, std::tuple(0, '1', 2));
+    EXPECT_EQ(it.skip_suffix(2), 1U);
+    EXPECT_EQ(*it, std::tuple(0, '2', 0));
+    EXPECT_EQ(it.skip_suffix(1), 0U);
+    EXPECT_EQ(*it, std::tuple(1, '0', 0));
+    EXPECT_EQ(it.skip_suffix(0), 0U);
+    EXPECT_EQ(*it, std::tuple(2, '0', 0));
+    it.skip_suffix(0);
+    it.skip_suffix(0);
+    EXPECT_EQ(it, cpv.end());
+}
+
+TEST(general, filtered_cartesian_product) {
+    auto const digits = std::views::iota(0, 10);
+    auto cpv = cartesian_product(digits, digits, digits);
+
+    // the triples of ascending digits whose sum is 12
+    std::size_t calls = 0;
+    auto filtered =
+        filtered_cartesian_product(
+            cpv,
+            [&](int) { ++calls; return true; },
+            [&](int const a, int const b) { ++calls; return a < b && a + b < 12; },
+            [&](int const a, int const b, int const c) { ++calls; return b < c && a + b + c == 12; }
+        )
+    ;
+    static_assert(std::ranges::forward_range<decltype(filtered)> && std::ranges::view<decltype(filtered)>);
+
+    std::vector<std::tuple<int, int, int>> expected{};
+    for (auto const& [a, b, c] : cpv) {
+        if (a < b && b < c && a + b + c == 12) {
+            expected.emplace_back(a, b, c);
+        }
+    }
+    check_equal(filtered, expected);
+    EXPECT_LT(calls, 1000U / 2);
+
+    // the innermost predicates may be omitted
+    auto const pairs = filtered_cartesian_product(cpv, [](int const a) { return a == 7; }, [](int const a, int const b) { return a == b; });
+    EXPECT_EQ(std::ranges::distance(pairs), 10);
+    EXPECT_EQ(*pairs.begin(), std::tuple(7, 7, 0));
+
+    auto const none = filtered_cartesian_product(cpv, [](int) { return false; });
+    EXPECT_TRUE(std::ranges::empty(none));
+
+    // the predicates may capture, i.e. not be assignable, and the product is a view all the same
+    auto const k = 7;
+    auto const firsts = filtered_cartesian_product(cpv, [k](int const a) { return a != k; }) | std::views::take(2);
+    check_equal(firsts, { std::tuple(0, 0, 0), std::tuple(0, 0, 1) });
+    auto const equal_k = [k](int const a) { return a == k; };
+    auto reassigned = filtered_cartesian_product(cpv, equal_k);
+    reassigned = filtered_cartesian_product(cpv, equal_k);
+    EXPECT_EQ(*reassigned.begin(), std::tuple(7, 0, 0));
+
+    // the search for the first tuple is done once, as begin() has to be amortized constant time
+    calls = 0;
+    auto const rejected = filtered_cartesian_product(cpv, [&](int) { ++calls; return false; });
+    EXPECT_EQ(rejected.begin(), rejected.end());
+    EXPECT_TRUE(std::ranges::empty(rejected));
+    EXPECT_EQ(std::ranges::distance(rejected), 0);
+    EXPECT_EQ(calls, 10U);
+
+    // the copies search on their own
+    auto const copy = rejected;
+    EXPECT_EQ(copy.begin(), copy.end());
+    EXPECT_EQ(calls, 20U);
+
+    // only products whose iterators can skip suffixes can be filtered
+    auto const filterable = [](auto& product) {
+        return requires { filtered_cartesian_product(product, [](int) { return true; }); };
+    };
+    auto compact = cpv.compact();
+    auto ordered = cpv.ordered<2, 1, 0>();
+    static_assert(filterable(cpv));
+    static_assert(!filterable(compact));
+    static_assert(!filterable(ordered));
+}
+
+TEST(general, reflected) {
+    auto cpv = cartesian_product(vector, list, std::views::iota(0, 2));
+    auto reflected = cpv.reflected();
+    static_assert(std::ranges::forward_range<decltype(reflected)>);
+    static_assert(std::same_as<std::ranges::range_reference_t<decltype(reflected)>, std::ranges::range_reference_t<decltype(cpv)>>);
+
+    check_equal(
+        reflected | std::views::take(10),
+        std::initializer_list<std::tuple<int, int, int>>{
+            { 0, 0, 0 }, { 0, 0, 1 }, { 0, 1, 1 }, { 0, 1, 0 }, { 0, 2, 0 },
+            { 0, 2, 1 }, { 0, 3, 1 }, { 0, 3, 0 }, { 1, 3, 0 }, { 1, 3, 1 }
+        }
+    );
+
+    // every tuple is visited once, and the running sum is kept by the changes alone
+    std::vector<std::tuple<int, int, int>> visited{};
+    auto it = reflected.begin();
+    auto sum = 0;
+    for (visited.push_back(*it++); it != std::default_sentinel; visited.push_back(*it++)) {
+        auto const& [a, b, c] = visited.back();
+        sum = a + b + c;
+        it.visit_change(
+            [&](auto const level, int const previous, int const current) {
+                EXPECT_EQ(level, it.changed());
+                EXPECT_EQ(std::get<level>(visited.back()), previous);
+                EXPECT_EQ(std::get<level>(*it), current);
+                sum += current - previous;
+            }
+        );
+        auto const& [x, y, z] = *it;
+        EXPECT_EQ(sum, x + y + z);
+        EXPECT_EQ((a != x) + (b != y) + (c != z), 1);
+    }
+    EXPECT_EQ(it, reflected.end());
+    std::ranges::sort(visited);
+    check_equal(visited, cpv);
+
+    // nothing has changed before the first increment, so the natural loop can visit the changes from the beginning
+    auto const begin = reflected.begin();
+    EXPECT_EQ(begin.changed(), 3U);
+    std::size_t visits = 0;
+    begin.visit_change([&](auto, int, int) { ++visits; });
+    EXPECT_EQ(visits, 0U);
+    sum = 0;
+    for (auto it = reflected.begin(); it != std::default_sentinel; ++it) {
+        it.visit_change([&](auto, int const previous, int const current) { sum += current - previous; ++visits; });
+        auto const& [x, y, z] = *it;
+        EXPECT_EQ(sum, x + y + z);
+    }
+    EXPECT_EQ(visits, 23U);
+
+    auto const const_reflected = std::as_const(cpv).reflected();
+    static_assert(std::same_as<std::ranges::range_reference_t<decltype(const_reflected)>, std::tuple<int const&, int const&, int>>);
+    EXPECT_EQ(std::ranges::distance(const_reflected), 24);
+
+    // a temporary product can be traversed only if its iterators don't refer to it
+    EXPECT_TRUE(cartesian_product(vector, empty).reflected().empty());
+    auto borrowed = cartesian_product(vector, list);
+    check_equal(cartesian_product(vector, list).reflected(), borrowed.reflected());
+    auto owning = cartesian_product(vector, std::list{ 0, 1 });
+    auto const reflectable = [](auto&& cpv) {
+        return requires { std::forward<decltype(cpv)>(cpv).reflected(); };
+    };
+    static_assert(reflectable(owning) && !reflectable(std::move(owning)));
+
+    // the ends of non-common views are compared against without walking the views again
+    auto const prefix = vector | std::views::take_while([](int const i) { return i < 2; });
+    auto const non_common = cartesian_product(prefix, list, prefix);
+    static_assert(!std::ranges::common_range<decltype(prefix)>);
+    EXPECT_EQ(std::ranges::distance(non_common.reflected()), 16);
+    EXPECT_EQ(*std::ranges::next(non_common.reflected().begin(), 3), std::tuple(0, 1, 0));
+    EXPECT_EQ(*std::ranges::next(non_common.reflected().begin(), 8), std::tuple(1, 3, 0));
+}
+
+TEST(general, ordered) {
+    auto cpv = cartesian_product(vector, list, std::views::iota(0, 2));
+    {
+        // the views are traversed in the given order, but the tuples keep the order of the views
+        auto ordered = cpv.ordered<2, 0, 1>();
+        static_assert(std::ranges::bidirectional_range<decltype(ordered)>);
+        static_assert(std::same_as<std::ranges::range_reference_t<decltype(ordered)>, std::ranges::range_reference_t<decltype(cpv)>>);
+
+        check_equal(
+            ordered | std::views::take(6),
+            std::initializer_list<std::tuple<int, int, int>>{
+                { 0, 0, 0 }, { 0, 1, 0 }, { 0, 2, 0 }, { 0, 3, 0 }, { 1, 0, 0 }, { 1, 1, 0 }
+            }
+        );
+
+        std::vector<std::tuple<int, int, int>> tuples(ordered.begin(), ordered.end());
+        EXPECT_EQ(tuples.size(), 24U);
+        EXPECT_EQ(tuples[12], std::tuple(0, 0, 1));
+        std::ranges::sort(tuples);
+        check_equal(tuples, cpv);
+    }
+    {
+        check_equal(cpv.ordered<0, 1, 2>(), cpv);
+
+        // column-major
+        auto const random_access = cartesian_product(vector, vector, std::views::iota(0, 2));
+        auto const ordered = random_access.ordered<2, 1, 0>();
+        static_assert(std::ranges::random_access_range<decltype(ordered)>);
+        static_assert(std::same_as<std::ranges::range_reference_t<decltype(ordered)>, std::tuple<int const&, int const&, int>>);
+        EXPECT_EQ(ordered[1], std::tuple(1, 0, 0));
+        EXPECT_EQ(ordered[3], std::tuple(0, 1, 0));
+        EXPECT_EQ(ordered[9], std::tuple(0, 0, 1));
+        EXPECT_EQ(ordered.end() - ordered.begin(), 18);
+    }
+    {
+        // the views of a temporary product are moved into the ordered one
+        auto ordered = cartesian_product(std::vector{ 0, 1 }, std::list{ 2, 3, 4 }).ordered<1, 0>();
+        static_assert(std::same_as<std::ranges::range_reference_t<decltype(ordered)>, std::tuple<int&, int&>>);
+        check_equal(
+            ordered,
+            std::initializer_list<std::tuple<int, int>>{
+                { 0, 2 }, { 1, 2 }, { 0, 3 }, { 1, 3 }, { 0, 4 }, { 1, 4 }
+            }
+        );
+    }
+
+    auto const orderable = []<std::size_t... order>(auto& cpv, std::index_sequence<order...>) {
+        return requires { cpv.template ordered<order...>(); };
+    };
+    static_assert(orderable(cpv, std::index_sequence<1, 2, 0>{}));
+    static_assert(!orderable(cpv, std::index_sequence<0, 1>{}));
+    static_assert(!orderable(cpv, std::index_sequence<0, 1, 1>{}));
+    static_assert(!orderable(cpv, std::index_sequence<0, 1, 3>{}));
+}
+
+TEST(general, cached_cartesian_product) {
+    {
+        // the outermost range is read once, the inner pipelines are evaluated once
+        std::istringstream stream{ "10 20 30" };
+        std::size_t calls = 0;
+        auto squares = std::views::iota(0, 4) | std::views::transform([&](int const i) { ++calls; return i * i; });
+        auto odds = vector | std::views::filter([](int const i) { return i % 2 == 1; });
+
+        auto cached = cached_cartesian_product(std::views::istream<int>(stream), squares, odds);
+        static_assert(std::ranges::input_range<decltype(cached)> && !std::ranges::forward_range<decltype(cached)>);
+        static_assert(std::same_as<std::ranges::range_reference_t<decltype(cached)>, std::tuple<int&, int const&, int const&>>);
+        EXPECT_EQ(calls, 4U);
+
+        std::vector<std::tuple<int, int, int>> tuples{};
+        for (auto const& [outer, square, odd] : cached) {
+            tuples.emplace_back(outer, square, odd);
+        }
+        check_equal(tuples, cartesian_product(std::array{ 10, 20, 30 }, std::array{ 0, 1, 4, 9 }, std::array{ 1 }));
+        EXPECT_EQ(calls, 4U);
+    }
+    {
+        // the elements of an outermost range of prvalues are kept by the iterator for the tuples they are part of,
+        // so the tuples can't outlive it, as they could if the product was a forward_range
+        auto cached = cached_cartesian_product(std::views::iota(0, 3) | std::views::transform([](int const i) { return i * 10; }), list);
+        static_assert(!std::ranges::forward_range<decltype(cached)> && std::ranges::sized_range<decltype(cached)>);
+        static_assert(std::same_as<std::ranges::range_reference_t<decltype(cached)>, std::tuple<int const&, int const&>>);
+#if __cpp_lib_ranges_zip >= 202110L
+        // std::tuple<int const&, int const&> and std::tuple<int, int> have a common reference since C++23 only
+        static_assert(std::ranges::input_range<decltype(cached)>);
+#endif
+        EXPECT_EQ(cached.size(), 12U);
+        EXPECT_EQ(std::ranges::distance(cached.begin(), cached.end()), 12);
+        EXPECT_EQ(*std::ranges::next(cached.begin(), 5), std::tuple(10, 1));
+    }
+
+    {
+        // the elements of an outermost range of lvalues are referred to instead
+        auto cached = cached_cartesian_product(vector, list);
+        static_assert(std::ranges::forward_range<decltype(cached)> && std::ranges::sized_range<decltype(cached)>);
+        static_assert(std::same_as<std::ranges::range_reference_t<decltype(cached)>, std::tuple<int&, int const&>>);
+        auto const begin = cached.begin();
+        EXPECT_EQ(&std::get<0>(*std::ranges::next(begin, 4)), &vector[1]);
+    }
+
+    EXPECT_TRUE(std::ranges::empty(cached_cartesian_product(vector, list, empty)));
+}
+
+TEST(general, streaming_cartesian_product) {
+    std::vector<int> inner(10'000);
+    std::iota(inner.begin(), inner.end(), 0);
+    {
+        // an outermost range that can be read only once is streamed by cartesian_product as well
+        std::istringstream stream{ "1 2 3" };
+        auto streamed = cartesian_product(std::views::istream<int>(stream), inner);
+        static_assert(std::same_as<decltype(streamed), decltype(cached_cartesian_product(std::views::istream<int>(stream), inner))>);
+        EXPECT_EQ(streamed.spilled(), 0U);
+
+        long sum = 0;
+        for (auto const& [outer, element] : streamed) {
+            sum += outer * element;
+        }
+        EXPECT_EQ(sum, 6L * (9'999L * 10'000L / 2));
+    }
+#if __has_include(<sys/mman.h>) && __has_include(<unistd.h>)
+    {
+        // the buffers beyond the memory limit are placed in temporary files
+        std::istringstream stream{ "1 2 3" };
+        auto streamed = cartesian_product(cartesian_memory_limit{ 1024 }, std::views::istream<int>(stream), inner, std::views::iota(0, 2));
+        EXPECT_GE(streamed.spilled(), inner.size() * sizeof(int));
+
+        std::size_t count = 0;
+        auto it = streamed.begin();
+        for (; it != streamed.end(); ++it) {
+            auto const& [outer, element, parity] = *it;
+            EXPECT_EQ(element, inner[count / 2 % inner.size()]);
+            EXPECT_EQ(parity, static_cast<int>(count % 2));
+            ++count;
+        }
+        EXPECT_EQ(count, 3 * 2 * inner.size());
+    }
+#else
+    EXPECT_THROW(cached_cartesian_product(cartesian_memory_limit{ 0 }, vector, inner), std::bad_alloc);
+#endif
+}
+
+TEST(general, cartesian_batches) {
+    std::size_t produced = 0;
+    auto counted = std::views::iota(0, 4) | std::views::transform([&](int const i) { ++produced; return i; });
+    auto cpv = cartesian_product(vector, counted);
+
+    cartesian_local_executor executor{};
+    std::vector<std::tuple<int, int>> consumed{};
+    std::vector<std::size_t> sizes{};
+    std::size_t steps = 0;
+
+    auto const consumer =
+        [&](cartesian_batch_generator<std::ranges::range_reference_t<decltype(cpv)>> batches) -> cartesian_local_executor::task {
+            while (true) {
+                auto const batch = co_await batches.next();
+                if (batch.empty()) {
+                    break;
+                }
+
+                // the producer doesn't run ahead of the consumer
+                EXPECT_EQ(produced, consumed.size() + batch.size());
+                sizes.push_back(batch.size());
+                consumed.insert(consumed.end(), batch.begin(), batch.end());
+
+                // e.g. waiting for the downstream I/O, which lets the other tasks proceed
+                co_await executor.schedule();
+            }
+        }
+    ;
+    auto const ticker =
+        [&]() -> cartesian_local_executor::task {
+            for (int i = 0; i != 5; ++i) {
+                ++steps;
+                co_await executor.schedule();
+            }
+        }
+    ;
+
+    executor.spawn(consumer(cartesian_batches(cpv, 5)));
+    executor.spawn(ticker());
+    executor.run();
+
+    check_equal(sizes, { 5U, 5U, 2U });
+    check_equal(consumed, cpv);
+    EXPECT_EQ(steps, 5U);
+
+    // the exceptions of the producer reach the consumer
+    auto throwing = cartesian_product(vector | std::views::transform([](int const i) { return i == 2 ? throw std::runtime_error{ "2" } : i; }), vector);
+    std::size_t batches = 0;
+    auto const counter =
+        [&](auto generator) -> cartesian_local_executor::task {
+            while (true) {
+                auto const batch = co_await generator.next();
+                if (batch.empty()) {
+                    break;
+                }
+                ++batches;
+            }
+        }
+    ;
+    executor.spawn(counter(cartesian_batches(throwing, 4)));
+    EXPECT_THROW(executor.run(), std::runtime_error);
+    EXPECT_EQ(batches, 1U);
+}
+
+TEST(general, cartesian_reduce) {
+    // the separable reductions give the same results as the enumeration of the tuples
+    auto const enumerated = [](auto op) { return [op](auto accumulator, auto const& tuple) { return op(std::move(accumulator), tuple); }; };
+    auto const check =
+        [&](auto& cpv) {
+            EXPECT_EQ(cartesian_reduce(cpv, cartesian_reduction::sum{}, 1L), cartesian_reduce(cpv, enumerated(cartesian_reduction::sum{}), 1L));
+            EXPECT_EQ(cartesian_reduce(cpv, cartesian_reduction::product{}, 2.0), cartesian_reduce(cpv, enumerated(cartesian_reduction::product{}), 2.0));
+            EXPECT_EQ(cartesian_reduce(cpv, cartesian_reduction::min{}, 100), cartesian_reduce(cpv, enumerated(cartesian_reduction::min{}), 100));
+            EXPECT_EQ(cartesian_reduce(cpv, cartesian_reduction::max{}, -100), cartesian_reduce(cpv, enumerated(cartesian_reduction::max{}), -100));
+
+            std::map<int, std::size_t> const init{ { 3, 10 } };
+            EXPECT_EQ(cartesian_reduce(cpv, cartesian_reduction::sum_histogram{}, init), cartesian_reduce(cpv, enumerated(cartesian_reduction::sum_histogram{}), init));
+        }
+    ;
+
+    std::array<int, 3> const array{ 1, 2, 3 };
+    {
+        auto cpv = cartesian_product(list, std::views::iota(1, 4), array);
+        check(cpv);
+        EXPECT_EQ(cartesian_reduce(cpv, cartesian_reduction::sum{}, 0L), 4 * 3 * 3 * (1.5 + 2 + 2));
+        EXPECT_EQ(cartesian_reduce(cpv, cartesian_reduction::max{}, 0), 3);
+        check(std::as_const(cpv));
+    }
+    {
+        auto cpv = cartesian_product(vector, empty);
+        check(cpv);
+        EXPECT_EQ(cartesian_reduce(cpv, cartesian_reduction::min{}, 100), 100);
+        EXPECT_TRUE(cartesian_reduce(cpv, cartesian_reduction::sum_histogram{}, std::map<int, int>{}).empty());
+    }
+    {
+        auto cpv = cartesian_product(array, array);
+        auto const histogram = cartesian_reduce(cpv, cartesian_reduction::sum_histogram{}, std::map<int, int>{});
+        check_equal(histogram, std::map<int, int>{ { 2, 1 }, { 3, 2 }, { 4, 3 }, { 5, 2 }, { 6, 1 } });
+
+        // any other reduction of the tuples is evaluated by enumeration
+        EXPECT_EQ(cartesian_reduce(cpv, [](int const count, auto const& tuple) { return count + (std::get<0>(tuple) < std::get<1>(tuple)); }, 0), 3);
+    }
+    {
+        // 10^15 tuples, which would take days to enumerate
+        auto const big = std::views::iota(0, 100'000);
+        auto const cpv = cartesian_product(big, big, big);
+        EXPECT_EQ(cartesian_reduce(cpv, cartesian_reduction::min{}, 5), 0);
+        EXPECT_EQ(cartesian_reduce(cpv, cartesian_reduction::sum{}, 0.0), 3.0 * 1e10 * (99'999.0 * 100'000.0 / 2));
+    }
+}
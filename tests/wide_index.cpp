@@ -0,0 +1,53 @@
+#define CARTESIAN_PRODUCT_VIEW_WIDE_INDEX
+
+#include <cstdint>
+#include <iterator>
+#include <limits>
+#include <ranges>
+#include <tuple>
+#include <type_traits>
+
+#include "gtest/gtest.h"
+
+#include "../cartesian_product_view.h"
+
+__extension__ using int128 = __int128;
+__extension__ using uint128 = unsigned __int128;
+
+// 454279 * 31252369 * 649657 == 2^63 - 1
+auto const iota0 = std::views::iota(0, 454279);
+auto const iota1 = std::views::iota(0, 31252369);
+auto const iota2 = std::views::iota(0, 649657);
+auto const iota3 = std::views::iota(0, 2);
+
+TEST(wide_index, beyond_64_bits) {
+    auto const cpv = cartesian_product(iota0, iota1, iota2, iota3);
+    using difference_type = std::iter_difference_t<std::ranges::iterator_t<decltype(cpv)>>;
+    static_assert(std::is_same_v<difference_type, int128>);
+
+    // 2^64 - 2 tuples
+    auto const expected = (static_cast<uint128>(std::numeric_limits<std::int64_t>::max())) * 2;
+    ASSERT_TRUE(cpv.checked_size());
+    EXPECT_TRUE(*cpv.checked_size() == expected);
+    EXPECT_TRUE(cpv.size() == expected);
+
+    auto const size = static_cast<difference_type>(expected);
+    auto const begin = std::ranges::begin(cpv);
+    auto const end = std::ranges::end(cpv);
+    EXPECT_TRUE(end - begin == size);
+    EXPECT_EQ(*(end - 1), std::tuple(454278, 31252368, 649656, 1));
+    EXPECT_EQ(cpv.at(size - 2), std::tuple(454278, 31252368, 649656, 0));
+    EXPECT_EQ(cpv.at(size / 2), std::tuple(227139, 15626184, 324828, 1));
+    EXPECT_TRUE(cpv.index_of(begin + (size - 3)) == size - 3);
+    EXPECT_EQ(std::ranges::distance(cpv.partition(size - 5, size)), 5);
+
+    auto const chunks = cpv.chunks(3);
+    EXPECT_TRUE(std::ranges::size(chunks[0]) + std::ranges::size(chunks[1]) + std::ranges::size(chunks[2]) == expected);
+}
+
+TEST(wide_index, checked_size) {
+    // 31252369^5 < 2^127 - 1 < 31252369^6
+    EXPECT_TRUE(cartesian_product(iota1, iota1, iota1, iota1, iota1).checked_size());
+    EXPECT_FALSE(cartesian_product(iota1, iota1, iota1, iota1, iota1, iota1).checked_size());
+    EXPECT_EQ(cartesian_product(iota1, iota1, iota1, iota1, iota1, iota1, std::views::iota(0, 0)).checked_size(), 0U);
+}